@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "backgroundcache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+const QString ImageSuffix = ".img";
+const QString ProcessedSuffix = ".path";
+const QString LocalImageSuffix = ".jpg";
+
+// 每个工作区各有普通背景和模糊背景两张图片
+const int MaxImageCount = 8;
+// 缩放后的图片按原始像素保存, 4K 屏幕下单张约 33 MB, 总大小限制为可保留当前屏幕的普通背景和模糊背景
+const qint64 MaxImageBytes = 96 * 1024 * 1024;
+const int MaxProcessedCount = 32;
+
+const quint32 ImageMagic = 0x44424731;
+
+struct ImageHeader {
+    quint32 magic;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+    qreal ratio;
+};
+
+void releaseMappedFile(void *info)
+{
+    // 关闭文件时解除内存映射
+    delete static_cast<QFile *>(info);
+}
+}
+
+QMutex BackgroundCache::m_cacheMutex;
+
+/**
+ * @brief BackgroundCache::key 生成缓存键
+ * @param sourcePath 源文件路径
+ * @param effect 处理方式
+ * @param geometry 屏幕区域, 缓存处理后的文件路径时为空
+ * @param ratio 屏幕缩放比例
+ * @return 缓存键, 源文件不存在时返回空字符串
+ */
+QString BackgroundCache::key(const QString &sourcePath, const QString &effect, const QRect &geometry, const qreal ratio)
+{
+    const QFileInfo info(sourcePath);
+    if (!info.isFile())
+        return QString();
+
+    const QString identity = QString("%1|%2|%3|%4|%5,%6,%7,%8|%9")
+            .arg(info.absoluteFilePath()).arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch())
+            .arg(effect).arg(geometry.x()).arg(geometry.y()).arg(geometry.width()).arg(geometry.height())
+            .arg(qRound(ratio * 100));
+
+    return QCryptographicHash::hash(identity.toUtf8(), QCryptographicHash::Sha1).toHex();
+}
+
+/**
+ * @brief BackgroundCache::image 以内存映射的方式读取缓存的图片, 不需要再次解码
+ * @param key 缓存键
+ * @return 缓存的图片, 未命中时返回空图片
+ */
+QImage BackgroundCache::image(const QString &key)
+{
+    if (key.isEmpty())
+        return QImage();
+
+    const QString filePath = entryPath(key, ImageSuffix);
+    QFile *file = new QFile(filePath);
+    if (!file->open(QIODevice::ReadOnly) || file->size() < qint64(sizeof(ImageHeader))) {
+        delete file;
+        return QImage();
+    }
+
+    const uchar *data = file->map(0, file->size());
+    const ImageHeader *header = reinterpret_cast<const ImageHeader *>(data);
+    if (!data || header->magic != ImageMagic || header->width <= 0 || header->height <= 0
+            || file->size() != qint64(sizeof(ImageHeader)) + qint64(header->bytesPerLine) * header->height) {
+        delete file;
+        return QImage();
+    }
+
+    QImage image(data + sizeof(ImageHeader), header->width, header->height, header->bytesPerLine,
+                 QImage::Format(header->format), releaseMappedFile, file);
+    image.setDevicePixelRatio(header->ratio);
+
+    touch(filePath);
+    return image;
+}
+
+/**
+ * @brief BackgroundCache::insertImage 将处理后的图片原始数据写入缓存
+ * @param key 缓存键
+ * @param image 图片
+ */
+void BackgroundCache::insertImage(const QString &key, const QImage &image)
+{
+    if (key.isEmpty() || image.isNull())
+        return;
+
+    // 只保存像素数据, 带颜色表的格式需先转换
+    if (image.colorCount() > 0) {
+        insertImage(key, image.convertToFormat(QImage::Format_RGB32));
+        return;
+    }
+
+    QMutexLocker locker(&m_cacheMutex);
+
+    QSaveFile file(entryPath(key, ImageSuffix));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    const ImageHeader header { ImageMagic, image.width(), image.height(), image.bytesPerLine(),
+                               image.format(), image.devicePixelRatio() };
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes());
+    if (!file.commit()) {
+        qWarning() << "write background cache failed:" << file.errorString();
+        return;
+    }
+
+    evict(ImageSuffix, MaxImageCount, MaxImageBytes);
+}
+
+/**
+ * @brief BackgroundCache::processedFile 获取缓存的模糊、特效处理后的文件路径
+ * @param key 缓存键
+ * @return 处理后的文件路径, 未命中或文件已被删除时返回空字符串
+ */
+QString BackgroundCache::processedFile(const QString &key)
+{
+    if (key.isEmpty())
+        return QString();
+
+    const QString filePath = entryPath(key, ProcessedSuffix);
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return QString();
+
+    const QString processed = QString::fromUtf8(file.readAll());
+    if (!QFile::exists(processed))
+        return QString();
+
+    touch(filePath);
+    return processed;
+}
+
+void BackgroundCache::insertProcessedFile(const QString &key, const QString &file)
+{
+    if (key.isEmpty() || file.isEmpty())
+        return;
+
+    QMutexLocker locker(&m_cacheMutex);
+
+    QSaveFile entry(entryPath(key, ProcessedSuffix));
+    if (!entry.open(QIODevice::WriteOnly))
+        return;
+
+    entry.write(file.toUtf8());
+    if (!entry.commit())
+        return;
+
+    evict(ProcessedSuffix, MaxProcessedCount);
+}
+
+/**
+ * @brief BackgroundCache::insertProcessedImage 保存本地处理后的背景图片, 并记录为该缓存键的处理结果
+ * @param key 缓存键
+ * @param image 处理后的图片
+ * @return 图片文件路径, 保存失败时返回空字符串
+ */
+QString BackgroundCache::insertProcessedImage(const QString &key, const QImage &image)
+{
+    if (key.isEmpty() || image.isNull())
+        return QString();
+
+    const QString filePath = entryPath(key, LocalImageSuffix);
+    {
+        QMutexLocker locker(&m_cacheMutex);
+
+        QSaveFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "JPG", 90) || !file.commit())
+            return QString();
+
+        evict(LocalImageSuffix, MaxImageCount);
+    }
+
+    insertProcessedFile(key, filePath);
+    return filePath;
+}
+
+/**
+ * @brief BackgroundCache::isCachedFile 判断文件是否为缓存目录中本地生成的文件
+ * @param file 文件路径
+ * @return 是缓存目录中的文件时返回 true
+ */
+bool BackgroundCache::isCachedFile(const QString &file)
+{
+    return QFileInfo(file).absolutePath() == QDir(cacheDir()).absolutePath();
+}
+
+QString BackgroundCache::cacheDir()
+{
+    static const QString dir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+            + "/deepin/dde-launcher/backgrounds";
+    return dir;
+}
+
+void BackgroundCache::clear()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    QDir(cacheDir()).removeRecursively();
+}
+
+QString BackgroundCache::entryPath(const QString &key, const QString &suffix)
+{
+    QDir dir(cacheDir());
+    if (!dir.exists())
+        dir.mkpath(".");
+
+    return dir.filePath(key + suffix);
+}
+
+/**
+ * @brief BackgroundCache::touch 更新条目的修改时间, 作为最近使用时间
+ * @param filePath 条目文件路径
+ */
+void BackgroundCache::touch(const QString &filePath)
+{
+    QFile file(filePath);
+    if (file.open(QIODevice::ReadWrite))
+        file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+}
+
+/**
+ * @brief BackgroundCache::evict 按最近使用时间淘汰超出数量或总大小的条目, 最近使用的条目始终保留
+ * @param suffix 条目类型
+ * @param maxCount 保留的最大数量
+ * @param maxBytes 保留的最大总大小, 小于 0 时不限制
+ */
+void BackgroundCache::evict(const QString &suffix, const int maxCount, const qint64 maxBytes)
+{
+    const QFileInfoList entries = QDir(cacheDir()).entryInfoList(QStringList() << ("*" + suffix), QDir::Files, QDir::Time);
+
+    qint64 totalBytes = 0;
+    for (int i = 0; i < entries.size(); ++i) {
+        totalBytes += entries.at(i).size();
+        if (i == 0)
+            continue;
+
+        if (i >= maxCount || (maxBytes >= 0 && totalBytes > maxBytes))
+            QFile::remove(entries.at(i).absoluteFilePath());
+    }
+}
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BACKGROUNDCACHE_H
+#define BACKGROUNDCACHE_H
+
+#include <QImage>
+#include <QMutex>
+#include <QRect>
+#include <QString>
+
+/**
+ * @brief The BackgroundCache class
+ * 本地持久化的背景缓存, 记录壁纸经过模糊、特效处理后的文件, 以及按屏幕尺寸缩放后的背景图片,
+ * 缓存键由源文件路径、大小、修改时间、屏幕区域、缩放比例及处理方式组成, 超出数量或总大小时淘汰最久未使用的条目
+ */
+class BackgroundCache
+{
+public:
+    static QString key(const QString &sourcePath, const QString &effect, const QRect &geometry = QRect(), const qreal ratio = 1.0);
+
+    static QImage image(const QString &key);
+    static void insertImage(const QString &key, const QImage &image);
+
+    static QString processedFile(const QString &key);
+    static void insertProcessedFile(const QString &key, const QString &file);
+    static QString insertProcessedImage(const QString &key, const QImage &image);
+    static bool isCachedFile(const QString &file);
+
+    static QString cacheDir();
+    static void clear();
+
+private:
+    static QString entryPath(const QString &key, const QString &suffix);
+    static void touch(const QString &filePath);
+    static void evict(const QString &suffix, const int maxCount, const qint64 maxBytes = -1);
+
+private:
+    static QMutex m_cacheMutex;
+};
+
+#endif // BACKGROUNDCACHE_H
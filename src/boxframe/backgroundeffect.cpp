@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "backgroundeffect.h"
+#include "backgroundcache.h"
+
+#include <QDebug>
+#include <QImageReader>
+#include <QtConcurrent>
+
+#include <numeric>
+
+namespace {
+// 模糊处理前将图片缩小到该宽度以内, 模糊后的图片放大显示时看不出差别
+const int BlurImageWidth = 960;
+const int BlurRadius = 12;
+const int BlurPassCount = 3;
+
+// 色调处理时叠加的黑色比例, 与 dde-pixmix 的效果接近
+const int PixmixDarken = 80;
+
+/**
+ * @brief boxBlurLine 对一行或一列像素做一次盒式模糊
+ * @param src 源像素起始地址
+ * @param dst 目标像素起始地址
+ * @param length 像素个数
+ * @param stride 相邻像素的字节间隔
+ * @param radius 模糊半径
+ */
+void boxBlurLine(const uchar *src, uchar *dst, const int length, const int stride, const int radius)
+{
+    const int window = radius * 2 + 1;
+    int sum[4] = { 0, 0, 0, 0 };
+
+    for (int i = -radius; i <= radius; ++i) {
+        const uchar *pixel = src + qBound(0, i, length - 1) * stride;
+        for (int c = 0; c < 4; ++c)
+            sum[c] += pixel[c];
+    }
+
+    for (int i = 0; i < length; ++i) {
+        uchar *pixel = dst + i * stride;
+        for (int c = 0; c < 4; ++c)
+            pixel[c] = uchar(sum[c] / window);
+
+        const uchar *next = src + qMin(i + radius + 1, length - 1) * stride;
+        const uchar *prev = src + qMax(i - radius, 0) * stride;
+        for (int c = 0; c < 4; ++c)
+            sum[c] += next[c] - prev[c];
+    }
+}
+}
+
+/**
+ * @brief BackgroundEffect::blur 多次水平、垂直方向的盒式模糊近似高斯模糊, 各行各列并行处理
+ * @param image 源图片
+ * @param radius 模糊半径
+ * @return 模糊后的图片
+ */
+QImage BackgroundEffect::blur(const QImage &image, const int radius)
+{
+    if (image.isNull() || radius <= 0)
+        return image;
+
+    QImage src = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    QImage tmp(src.size(), src.format());
+
+    const int width = src.width();
+    const int height = src.height();
+    const int bytesPerLine = src.bytesPerLine();
+
+    QVector<int> rows(height);
+    std::iota(rows.begin(), rows.end(), 0);
+    QVector<int> columns(width);
+    std::iota(columns.begin(), columns.end(), 0);
+
+    // 各线程只使用原始地址, 避免并发访问 QImage 时触发深拷贝
+    uchar *srcBits = src.bits();
+    uchar *tmpBits = tmp.bits();
+
+    for (int pass = 0; pass < BlurPassCount; ++pass) {
+        QtConcurrent::blockingMap(rows, [=](const int row) {
+            boxBlurLine(srcBits + row * bytesPerLine, tmpBits + row * bytesPerLine, width, 4, radius);
+        });
+        QtConcurrent::blockingMap(columns, [=](const int column) {
+            boxBlurLine(tmpBits + column * 4, srcBits + column * 4, height, bytesPerLine, radius);
+        });
+    }
+
+    return src;
+}
+
+/**
+ * @brief BackgroundEffect::pixmix 降低背景亮度, 保证背景上的白色文字清晰可见
+ * @param image 源图片
+ * @return 处理后的图片
+ */
+QImage BackgroundEffect::pixmix(const QImage &image)
+{
+    if (image.isNull())
+        return image;
+
+    QImage result = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const int bytesPerLine = result.bytesPerLine();
+    const int width = result.width();
+    uchar *bits = result.bits();
+
+    QVector<int> rows(result.height());
+    std::iota(rows.begin(), rows.end(), 0);
+
+    QtConcurrent::blockingMap(rows, [=](const int row) {
+        QRgb *line = reinterpret_cast<QRgb *>(bits + row * bytesPerLine);
+        for (int x = 0; x < width; ++x) {
+            const QRgb pixel = line[x];
+            line[x] = qRgba(qRed(pixel) * (255 - PixmixDarken) / 255,
+                            qGreen(pixel) * (255 - PixmixDarken) / 255,
+                            qBlue(pixel) * (255 - PixmixDarken) / 255,
+                            qAlpha(pixel));
+        }
+    });
+
+    return result;
+}
+
+/**
+ * @brief BackgroundEffect::blurFile 生成模糊并降低亮度后的背景文件
+ * @param filePath 壁纸文件路径
+ * @return 处理后的文件路径, 失败时返回壁纸文件路径
+ */
+QString BackgroundEffect::blurFile(const QString &filePath)
+{
+    return processFile(filePath, "local-blur-pixmix", true);
+}
+
+/**
+ * @brief BackgroundEffect::pixmixFile 生成降低亮度后的背景文件
+ * @param filePath 壁纸文件路径
+ * @return 处理后的文件路径, 失败时返回壁纸文件路径
+ */
+QString BackgroundEffect::pixmixFile(const QString &filePath)
+{
+    return processFile(filePath, "local-pixmix", false);
+}
+
+QString BackgroundEffect::processFile(const QString &filePath, const QString &effect, const bool blur)
+{
+    const QString key = BackgroundCache::key(filePath, effect);
+    const QString cachedFile = BackgroundCache::processedFile(key);
+    if (!cachedFile.isEmpty())
+        return cachedFile;
+
+    QImageReader reader(filePath);
+    const QSize size = reader.size();
+    if (blur && size.width() > BlurImageWidth)
+        reader.setScaledSize(size.scaled(BlurImageWidth, size.height(), Qt::KeepAspectRatio));
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "read wallpaper failed:" << filePath << reader.errorString();
+        return filePath;
+    }
+
+    if (blur)
+        image = BackgroundEffect::blur(image, BlurRadius);
+
+    const QString processed = BackgroundCache::insertProcessedImage(key, pixmix(image));
+    return processed.isEmpty() ? filePath : processed;
+}
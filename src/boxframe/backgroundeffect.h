@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BACKGROUNDEFFECT_H
+#define BACKGROUNDEFFECT_H
+
+#include <QImage>
+#include <QString>
+
+/**
+ * @brief The BackgroundEffect class
+ * 进程内的背景模糊及色调处理, 在 ImageBlur/ImageEffect 服务不可用或超时时代替服务生成背景图片
+ */
+class BackgroundEffect
+{
+public:
+    static QImage blur(const QImage &image, const int radius);
+    static QImage pixmix(const QImage &image);
+
+    static QString blurFile(const QString &filePath);
+    static QString pixmixFile(const QString &filePath);
+
+private:
+    static QString processFile(const QString &filePath, const QString &effect, const bool blur);
+};
+
+#endif // BACKGROUNDEFFECT_H
@@ -3,7 +3,10 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "backgroundmanager.h"
-#include "appsmanager.h"
+#include "backgroundcache.h"
+#include "backgroundeffect.h"
+#include "displaytopology.h"
+#include "idlemode.h"
 #include "util.h"
 
 #include <QApplication>
@@ -13,6 +16,12 @@ using namespace com::deepin;
 
 const QString DefaultWallpaper = "/usr/share/backgrounds/default_background.jpg";
 const QString DisplayInterface("com.deepin.daemon.Display");
+const QString BlurEffect = "blur-pixmix";
+const QString PlainEffect = "pixmix";
+// 图片处理服务的超时时间, 超时后使用本地处理的背景
+const int ImageEffectTimeout = 3000;
+// 模糊服务正在处理时等待 BlurDone 信号的时间, 超时后使用本地模糊的背景
+const int BlurDoneTimeout = 1000;
 
 static QString getLocalFile(const QString &file)
 {
@@ -20,21 +29,6 @@ static QString getLocalFile(const QString &file)
     return url.isLocalFile() ? url.toLocalFile() : url.url();
 }
 
-DisplayHelper::DisplayHelper(QObject *parent)
-    : QObject(parent)
-    , m_displayInter(new DisplayInter("com.deepin.daemon.Display", "/com/deepin/daemon/Display", QDBusConnection::sessionBus(), this))
-{
-    m_displayMode = m_displayInter->GetRealDisplayMode();
-
-    connect(m_displayInter, &DisplayInter::DisplayModeChanged, this, &DisplayHelper::updateDisplayMode);
-    connect(m_displayInter, &DisplayInter::PrimaryChanged, this, &DisplayHelper::updateDisplayMode);
-}
-
-void DisplayHelper::updateDisplayMode()
-{
-    m_displayMode = m_displayInter->GetRealDisplayMode();
-}
-
 BackgroundManager::BackgroundManager(QObject *parent)
     : QObject(parent)
     , m_currentWorkspace(-1)
@@ -44,101 +38,334 @@ BackgroundManager::BackgroundManager(QObject *parent)
     , m_appearanceInter(new AppearanceInter("com.deepin.daemon.Appearance", "/com/deepin/daemon/Appearance", QDBusConnection::sessionBus(), this))
     , m_displayInter(new DisplayInter(DisplayInterface, "/com/deepin/daemon/Display", QDBusConnection::sessionBus(), this))
     , m_fileName(QString())
+    , m_wallpaperChanged(true)
+    , m_refreshTimer(new QTimer(this))
+    , m_refreshPending(false)
+    , m_blurDoneTimer(new QTimer(this))
+    , m_blurDone(false)
+    , m_effectPool(new QThreadPool(this))
 {
     m_appearanceInter->setSync(false, false);
+    m_imageEffectInter->setTimeout(ImageEffectTimeout);
+    m_imageblur->setTimeout(ImageEffectTimeout);
 
     m_displayMode = m_displayInter->GetRealDisplayMode();
 
+    // 同一轮事件循环中的多次刷新请求合并为一次
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(0);
+    connect(m_refreshTimer, &QTimer::timeout, this, &BackgroundManager::refreshBackgrounds);
+
+    // 本地处理在单独的单线程池中排队, 新的请求开始时清空未执行的旧任务
+    m_effectPool->setMaxThreadCount(1);
+
+    m_blurDoneTimer->setSingleShot(true);
+    m_blurDoneTimer->setInterval(BlurDoneTimeout);
+    connect(m_blurDoneTimer, &QTimer::timeout, this, [ this ] {
+        processLocally(m_fileName, &BackgroundEffect::blurFile, true);
+    });
+    connect(DisplayTopology::instance(), &DisplayTopology::topologyChanged, this, &BackgroundManager::updateScreenBackgrounds);
+    connect(DisplayTopology::instance(), &DisplayTopology::dockRectChanged, this, &BackgroundManager::updateScreenBackgrounds);
+
     connect(m_wmInter, &__wm::WorkspaceSwitched, this, &BackgroundManager::updateBlurBackgrounds);
     connect(m_wmInter, &__wm::WorkspaceBackgroundChanged, this, &BackgroundManager::updateBlurBackgrounds);
     connect(m_appearanceInter, &AppearanceInter::Changed, this, &BackgroundManager::onAppearanceChanged);
     connect(m_displayInter, &DisplayInter::DisplayModeChanged, this, &BackgroundManager::onDisplayModeChanged);
     connect(m_displayInter, &DisplayInter::PrimaryChanged, this, &BackgroundManager::onPrimaryChanged);
-    connect(m_displayInter, &DisplayInter::DisplayModeChanged, this, &BackgroundManager::updateBlurBackgrounds);
+    connect(m_displayInter, &DisplayInter::DisplayModeChanged, this, &BackgroundManager::clearMonitorNames);
+    connect(m_displayInter, &DisplayInter::MonitorsChanged, this, &BackgroundManager::clearMonitorNames);
 
     connect(m_imageblur, &ImageEffeblur::BlurDone, this, &BackgroundManager::onGetBlurImageFromDbus);
+    connect(IdleMode::instance(), &IdleMode::idleChanged, this, &BackgroundManager::onIdleChanged);
 
     updateBlurBackgrounds();
 }
 
 void BackgroundManager::getImageDataFromDbus(const QString &filePath)
 {
-    // 异步获取模糊以及pixmix算法处理后的桌面背景(分类模式的视图背景)
-    QFutureWatcher<QString> *imageEffectWatcher = new QFutureWatcher<QString>(this);
-    connect(imageEffectWatcher, &QFutureWatcher<QString>::finished, this, [this, imageEffectWatcher]{
-        imageEffectWatcher->deleteLater();
-        m_blurBackground = imageEffectWatcher->result();
-        if (!m_blurBackground.isEmpty())
-            emit currentWorkspaceBlurBackgroundChanged(m_blurBackground);
-    });
-    QFuture<QString> imageblurFuture = QtConcurrent::run([this, filePath]() ->QString {
-        if (m_imageblur.isNull())
-            return filePath;
-
-        QDBusPendingReply<QString> blurReply = m_imageblur->Get(filePath);
-        blurReply.waitForFinished();
-        if (m_imageEffectInter.isNull())
-            return filePath;
-
-        // 处理完会触发BlurDone信号,总之 imageblurFuture 必须得有返回值,否则会导致imageEffectWatcher->result()获取不到值导致异常
-        QDBusPendingReply<QString> effectInterReply = m_imageEffectInter->Get("", blurReply.value());
-        effectInterReply.waitForFinished();
-        if (effectInterReply.isError())
-            return filePath;
-
-        return effectInterReply.value();
+    // 新的请求开始后, 之前未完成的请求结果不再使用
+    cancelPendingRequests();
+
+    // 壁纸处理过的结果已缓存时直接使用, 不再请求后端服务
+    const QString blurKey = BackgroundCache::key(filePath, BlurEffect);
+    const QString plainKey = BackgroundCache::key(filePath, PlainEffect);
+    const QString cachedBlurFile = BackgroundCache::processedFile(blurKey);
+    const QString cachedPlainFile = BackgroundCache::processedFile(plainKey);
+
+    if (!cachedBlurFile.isEmpty())
+        setBlurBackground(cachedBlurFile);
+    else
+        getBlurImageFromDbus(filePath, blurKey);
+
+    if (!cachedPlainFile.isEmpty())
+        setPlainBackground(cachedPlainFile);
+    else
+        getPlainImageFromDbus(filePath, plainKey);
+}
+
+/**
+ * @brief BackgroundManager::getBlurImageFromDbus 异步获取模糊以及pixmix算法处理后的桌面背景(分类模式的视图背景)
+ * @param filePath 壁纸文件路径
+ * @param cacheKey 处理结果的缓存键
+ */
+void BackgroundManager::getBlurImageFromDbus(const QString &filePath, const QString &cacheKey)
+{
+    // 服务不可用时在本地模糊处理
+    if (m_imageblur.isNull() || !m_imageblur->isValid() || m_imageEffectInter.isNull()) {
+        processLocally(filePath, &BackgroundEffect::blurFile, true);
+        return;
+    }
+
+    QDBusPendingCallWatcher *blurWatcher = watchCall(m_imageblur->Get(filePath));
+    connect(blurWatcher, &QDBusPendingCallWatcher::finished, this, [this, filePath, cacheKey](QDBusPendingCallWatcher *call) {
+        releaseWatcher(call);
+
+        QDBusPendingReply<QString> blurReply = *call;
+        if (blurReply.isError()) {
+            processLocally(filePath, &BackgroundEffect::blurFile, true);
+            return;
+        }
+
+        // 模糊处理未完成时返回空路径, 处理完会触发BlurDone信号, 超时仍未完成时再使用本地模糊的背景
+        if (blurReply.value().isEmpty()) {
+            if (!m_blurDone)
+                m_blurDoneTimer->start();
+            return;
+        }
+
+        getBlurEffectFromDbus(blurReply.value(), cacheKey);
     });
-    imageEffectWatcher->setFuture(imageblurFuture);
-
-    // 异步获取全屏桌面背景
-    QFutureWatcher<QString> *effectInterWatcher = new QFutureWatcher<QString> (this);
-    connect(effectInterWatcher, &QFutureWatcher<QString>::finished, this, [this, effectInterWatcher](){
-        effectInterWatcher->deleteLater();
-        m_background = effectInterWatcher->result();
-        if (!m_background.isEmpty())
-            emit currentWorkspaceBackgroundChanged(m_background);
+}
+
+/**
+ * @brief BackgroundManager::getBlurEffectFromDbus 按照dde-session-ui/dde-pixmix 的算法处理模糊后的背景
+ * @param blurFile 模糊处理后的文件路径
+ * @param cacheKey 处理结果的缓存键
+ */
+void BackgroundManager::getBlurEffectFromDbus(const QString &blurFile, const QString &cacheKey)
+{
+    if (m_imageEffectInter.isNull()) {
+        processLocally(blurFile, &BackgroundEffect::pixmixFile, true);
+        return;
+    }
+
+    QDBusPendingCallWatcher *effectWatcher = watchCall(m_imageEffectInter->Get("", blurFile));
+    connect(effectWatcher, &QDBusPendingCallWatcher::finished, this, [this, blurFile, cacheKey](QDBusPendingCallWatcher *call) {
+        releaseWatcher(call);
+
+        QDBusPendingReply<QString> effectReply = *call;
+        if (effectReply.isError()) {
+            processLocally(blurFile, &BackgroundEffect::pixmixFile, true);
+            return;
+        }
+
+        BackgroundCache::insertProcessedFile(cacheKey, effectReply.value());
+        setBlurBackground(effectReply.value());
     });
-    QFuture<QString> effectInterFuture = QtConcurrent::run([this, filePath]() ->QString {
-        if (!m_imageEffectInter)
-            return filePath;
-
-        QDBusPendingReply<QString> effectInterReply = m_imageEffectInter->Get("", filePath);
-        effectInterReply.waitForFinished();
-        if (effectInterReply.isError()) {
-            qWarning() << "ImageEffeblur Get error:" << effectInterReply.error();
-            return filePath;
+}
+
+/**
+ * @brief BackgroundManager::getPlainImageFromDbus 异步获取全屏桌面背景
+ * @param filePath 壁纸文件路径
+ * @param cacheKey 处理结果的缓存键
+ */
+void BackgroundManager::getPlainImageFromDbus(const QString &filePath, const QString &cacheKey)
+{
+    if (m_imageEffectInter.isNull() || !m_imageEffectInter->isValid()) {
+        processLocally(filePath, &BackgroundEffect::pixmixFile, false);
+        return;
+    }
+
+    QDBusPendingCallWatcher *effectWatcher = watchCall(m_imageEffectInter->Get("", filePath));
+    connect(effectWatcher, &QDBusPendingCallWatcher::finished, this, [this, filePath, cacheKey](QDBusPendingCallWatcher *call) {
+        releaseWatcher(call);
+
+        QDBusPendingReply<QString> effectReply = *call;
+        if (effectReply.isError()) {
+            qWarning() << "ImageEffeblur Get error:" << effectReply.error();
+            processLocally(filePath, &BackgroundEffect::pixmixFile, false);
+            return;
         }
-        return effectInterReply.value();
+
+        BackgroundCache::insertProcessedFile(cacheKey, effectReply.value());
+        setPlainBackground(effectReply.value());
     });
-    effectInterWatcher->setFuture(effectInterFuture);
 }
 
+/**
+ * @brief BackgroundManager::processLocally 服务不可用或处理失败时, 在单线程池中依次本地处理背景
+ * 本地处理的结果不作为服务的处理结果缓存, 下次仍优先使用服务
+ * @param filePath 待处理的文件路径
+ * @param effect 本地处理方法
+ * @param blurBackground 处理结果是否用作模糊背景
+ */
+void BackgroundManager::processLocally(const QString &filePath, QString (*effect)(const QString &), const bool blurBackground)
+{
+    QFutureWatcher<QString> *watcher = new QFutureWatcher<QString>(this);
+    m_pendingWatchers << watcher;
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, effect, blurBackground] {
+        releaseWatcher(watcher);
+
+        // 模糊服务已处理完成时, 不再使用本地模糊的结果
+        if (effect == &BackgroundEffect::blurFile && m_blurDone)
+            return;
+
+        if (blurBackground)
+            setBlurBackground(watcher->result());
+        else
+            setPlainBackground(watcher->result());
+    });
+    watcher->setFuture(QtConcurrent::run(m_effectPool, effect, filePath));
+}
+
+QDBusPendingCallWatcher *BackgroundManager::watchCall(const QDBusPendingCall &call)
+{
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    m_pendingWatchers << watcher;
+    return watcher;
+}
+
+void BackgroundManager::releaseWatcher(QObject *watcher)
+{
+    m_pendingWatchers.removeOne(watcher);
+    watcher->deleteLater();
+}
+
+/**
+ * @brief BackgroundManager::cancelPendingRequests 丢弃未完成的请求, 过期的处理结果不会再覆盖新的背景
+ * 尚未开始的本地处理任务直接移出线程池, 只有正在执行的任务会处理完成
+ */
+void BackgroundManager::cancelPendingRequests()
+{
+    m_effectPool->clear();
+    qDeleteAll(m_pendingWatchers);
+    m_pendingWatchers.clear();
+    m_blurDoneTimer->stop();
+    m_blurDone = false;
+}
+
+void BackgroundManager::setBlurBackground(const QString &file)
+{
+    m_blurBackground = file;
+    if (!m_blurBackground.isEmpty())
+        emit currentWorkspaceBlurBackgroundChanged(m_blurBackground);
+}
+
+void BackgroundManager::setPlainBackground(const QString &file)
+{
+    m_background = file;
+    if (!m_background.isEmpty())
+        emit currentWorkspaceBackgroundChanged(m_background);
+}
+
+/**
+ * @brief BackgroundManager::updateBlurBackgrounds 壁纸可能发生变化, 在本轮事件循环结束后统一刷新背景
+ */
 void BackgroundManager::updateBlurBackgrounds()
 {
-    const QScreen *screen = AppsManager::instance()->currentScreen();
+    m_wallpaperChanged = true;
+    scheduleRefresh();
+}
+
+/**
+ * @brief BackgroundManager::updateScreenBackgrounds 窗口位置变化时调用, 所在屏幕未变化时不刷新背景
+ */
+void BackgroundManager::updateScreenBackgrounds()
+{
+    scheduleRefresh();
+}
+
+/**
+ * @brief BackgroundManager::scheduleRefresh 启动器隐藏期间只记录刷新请求, 不处理背景图片
+ */
+void BackgroundManager::scheduleRefresh()
+{
+    if (IdleMode::instance()->isIdle()) {
+        m_refreshPending = true;
+        return;
+    }
+
+    m_refreshTimer->start();
+}
+
+/**
+ * @brief BackgroundManager::onIdleChanged 退出空闲状态时处理隐藏期间记录的刷新请求
+ * @param idle 是否处于空闲状态
+ */
+void BackgroundManager::onIdleChanged(bool idle)
+{
+    if (idle || !m_refreshPending)
+        return;
+
+    m_refreshPending = false;
+    m_refreshTimer->stop();
+    refreshBackgrounds();
+}
+
+void BackgroundManager::refreshBackgrounds()
+{
+    const QScreen *screen = DisplayTopology::instance()->currentScreen();
     if (!screen)
         return;
 
+    const QString screenName = monitorName(screen);
+    if (!m_wallpaperChanged && screenName == m_screenName)
+        return;
+
+    m_wallpaperChanged = false;
+
+    QString path = getLocalFile(m_wmInter->GetCurrentWorkspaceBackgroundForMonitor(screenName));
+    path = QFile::exists(path) ? path : DefaultWallpaper;
+
+    // 屏幕与壁纸文件均未变化时无需重新处理背景
+    const QDateTime lastModified = QFileInfo(path).lastModified();
+    if (screenName == m_screenName && path == m_fileName && lastModified == m_fileModified)
+        return;
+
+    m_screenName = screenName;
+    m_fileName = path;
+    m_fileModified = lastModified;
+
+    getImageDataFromDbus(m_fileName);
+}
+
+/**
+ * @brief BackgroundManager::monitorName 获取屏幕名称, 结果按屏幕位置缓存, 显示器配置变化时清空
+ * @param screen 屏幕
+ * @return 屏幕名称
+ */
+QString BackgroundManager::monitorName(const QScreen *screen)
+{
     QString screenName = screen->name();
 
     /* wayland下使用QScreen获取屏幕名称存在为空的情况，因此使用后端服务获取屏幕名称
     wayland下 当正常接入主机并显示，当显示模式为复制模式且屏幕名称为空时，更新屏幕的名称，否则直接使用任务栏所在屏幕的名称*/
-    if (isWaylandDisplay() && screenName.isEmpty()) {
-        const QList<QDBusObjectPath> monitorList = m_displayInter->monitors();
-        for (int i = 0; i < monitorList.size(); i++) {
-            DisplayMonitor monitor(DisplayInterface, QString("%1").arg(monitorList.at(i).path()), QDBusConnection::sessionBus(), this);
-            if ((monitor.enabled() == true) && (monitor.x() == screen->geometry().x())
-                    && (monitor.y() == screen->geometry().y()) && monitor.name() != screenName) {
-                screenName = monitor.name();
-                break;
-            }
+    if (!isWaylandDisplay() || !screenName.isEmpty())
+        return screenName;
+
+    const QPoint pos = screen->geometry().topLeft();
+    auto it = m_monitorNames.constFind(qMakePair(pos.x(), pos.y()));
+    if (it != m_monitorNames.constEnd())
+        return it.value();
+
+    const QList<QDBusObjectPath> monitorList = m_displayInter->monitors();
+    for (int i = 0; i < monitorList.size(); i++) {
+        DisplayMonitor monitor(DisplayInterface, QString("%1").arg(monitorList.at(i).path()), QDBusConnection::sessionBus(), this);
+        if ((monitor.enabled() == true) && (monitor.x() == pos.x())
+                && (monitor.y() == pos.y()) && monitor.name() != screenName) {
+            screenName = monitor.name();
+            break;
         }
     }
 
-    QString path = getLocalFile(m_wmInter->GetCurrentWorkspaceBackgroundForMonitor(screenName));
-    m_fileName = QFile::exists(path) ? path : DefaultWallpaper;
+    m_monitorNames.insert(qMakePair(pos.x(), pos.y()), screenName);
+    return screenName;
+}
 
-    getImageDataFromDbus(m_fileName);
+void BackgroundManager::clearMonitorNames()
+{
+    m_monitorNames.clear();
+    updateBlurBackgrounds();
 }
 
 void BackgroundManager::onAppearanceChanged(const QString &type, const QString &str)
@@ -161,7 +388,7 @@ void BackgroundManager::onPrimaryChanged(const QString &value)
     Q_UNUSED(value);
 
     m_displayMode = m_displayInter->GetRealDisplayMode();
-    updateBlurBackgrounds();
+    clearMonitorNames();
 }
 
 /**获取分类模式的视图模糊背景图片路径
@@ -173,27 +400,11 @@ void BackgroundManager::onPrimaryChanged(const QString &value)
 void BackgroundManager::onGetBlurImageFromDbus(const QString &file, const QString &blurFile, bool status)
 {
     // 信号返回的文件路径与本地获取的文件路径比对
-    if (status && file == m_fileName) {
-        // 异步获取pixmix处理模糊后的背景(分类模式的视图背景)
-        QFutureWatcher<QString> *imageEffectWatcher = new QFutureWatcher<QString>(this);
-        connect(imageEffectWatcher, &QFutureWatcher<QString>::finished, this, [this, imageEffectWatcher]{
-            imageEffectWatcher->deleteLater();
-            m_blurBackground = imageEffectWatcher->result();
-            if (!m_blurBackground.isEmpty())
-                emit currentWorkspaceBlurBackgroundChanged(m_blurBackground);
-        });
-
-        // 按照dde-session-ui/dde-pixmix 的算法处理
-        QFuture<QString> imageblurFuture = QtConcurrent::run([this, blurFile]() ->QString {
-            QDBusPendingReply<QString> effectInterReply = m_imageEffectInter->Get("", blurFile);
-            effectInterReply.waitForFinished();
-
-            if (effectInterReply.isError())
-                return blurFile;
-
-            return effectInterReply.value();
-        });
-
-        imageEffectWatcher->setFuture(imageblurFuture);
-    }
+    if (!status || file != m_fileName)
+        return;
+
+    // 服务已处理完成, 取消等待中的本地模糊处理
+    m_blurDoneTimer->stop();
+    m_blurDone = true;
+    getBlurEffectFromDbus(blurFile, BackgroundCache::key(file, BlurEffect));
 }
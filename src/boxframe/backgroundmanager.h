@@ -6,9 +6,13 @@
 #define BACKGROUNDMANAGER_H
 
 #include <QObject>
+#include <QPointer>
 #include <QDesktopWidget>
 #include <QScreen>
-#include <DSingleton>
+#include <QDBusPendingCallWatcher>
+#include <QDateTime>
+#include <QTimer>
+#include <QThreadPool>
 
 #include <com_deepin_wm.h>
 #include <com_deepin_daemon_imageeffect.h>
@@ -28,26 +32,6 @@ using AppearanceInter = com::deepin::daemon::Appearance;
 using DisplayInter = com::deepin::daemon::Display;
 using DisplayMonitor = com::deepin::daemon::display::Monitor;
 
-class DisplayHelper : public QObject, public Dtk::Core::DSingleton<DisplayHelper>
-{
-    Q_OBJECT
-    friend class Dtk::Core::DSingleton<DisplayHelper>;
-
-public:
-    inline int displayMode() const { return m_displayMode;}
-
-private:
-    explicit DisplayHelper(QObject *parent = nullptr);
-
-private slots:
-    void updateDisplayMode();
-
-private:
-    QPointer<DisplayInter> m_displayInter;
-    int m_displayMode;
-};
-
-
 class BackgroundManager : public QObject
 {
     Q_OBJECT
@@ -58,6 +42,17 @@ public:
 
 private:
     void getImageDataFromDbus(const QString &filePath);
+    QString monitorName(const QScreen *screen);
+    void getBlurImageFromDbus(const QString &filePath, const QString &cacheKey);
+    void getBlurEffectFromDbus(const QString &blurFile, const QString &cacheKey);
+    void getPlainImageFromDbus(const QString &filePath, const QString &cacheKey);
+    void processLocally(const QString &filePath, QString (*effect)(const QString &), const bool blurBackground);
+    QDBusPendingCallWatcher *watchCall(const QDBusPendingCall &call);
+    void releaseWatcher(QObject *watcher);
+    void cancelPendingRequests();
+    void setBlurBackground(const QString &file);
+    void setPlainBackground(const QString &file);
+    void scheduleRefresh();
 
 signals:
     void currentWorkspaceBackgroundChanged(const QString &background);
@@ -66,11 +61,17 @@ signals:
 
 public slots:
     void updateBlurBackgrounds();
+    void updateScreenBackgrounds();
     void onAppearanceChanged(const QString & type, const QString &str);
     void onDisplayModeChanged(uchar  value);
     void onPrimaryChanged(const QString & value);
     void onGetBlurImageFromDbus(const QString &file, const QString &blurFile, bool status);
 
+private slots:
+    void refreshBackgrounds();
+    void clearMonitorNames();
+    void onIdleChanged(bool idle);
+
 private:
     int m_currentWorkspace;
     mutable QString m_blurBackground;
@@ -83,6 +84,16 @@ private:
     QPointer<DisplayInter> m_displayInter;
     int m_displayMode;
     QString m_fileName;
+    QDateTime m_fileModified;
+    QString m_screenName;
+    bool m_wallpaperChanged;                            // 壁纸可能已变化, 刷新时需重新获取壁纸路径
+    QTimer *m_refreshTimer;
+    bool m_refreshPending;                              // 启动器隐藏期间收到的刷新请求, 显示前处理
+    QHash<QPair<int, int>, QString> m_monitorNames;     // wayland 下按屏幕位置缓存的屏幕名称
+    QList<QObject *> m_pendingWatchers;                 // 未完成的 D-Bus 调用及本地处理任务
+    QTimer *m_blurDoneTimer;                            // 等待模糊服务 BlurDone 信号的超时定时器
+    bool m_blurDone;                                    // 模糊服务已处理完当前壁纸, 本地模糊的结果不再使用
+    QThreadPool *m_effectPool;                          // 本地处理背景的单线程池, 只保留最新请求的任务
 };
 
 #endif // BACKGROUNDMANAGER_H
@@ -4,6 +4,8 @@
 
 #include "boxframe.h"
 #include "backgroundmanager.h"
+#include "backgroundcache.h"
+#include "displaytopology.h"
 #include "util.h"
 #include "constants.h"
 
@@ -14,6 +16,8 @@
 #include <QScreen>
 #include <QPainter>
 #include <QPaintEvent>
+#include <QImageReader>
+#include <QtConcurrent>
 
 /**
  * @brief BoxFrame::BoxFrame 桌面背景类
@@ -24,11 +28,16 @@ BoxFrame::BoxFrame(QWidget *parent)
     , m_defaultBg("/usr/share/backgrounds/default_background.jpg")
     , m_bgManager(nullptr)
     , m_useSolidBackground(false)
+    , m_backgroundWatcher(new QFutureWatcher<QImage>(this))
+    , m_blurBackgroundWatcher(new QFutureWatcher<QImage>(this))
 {
     m_useSolidBackground = getDConfigValue("useSolidBackground", false).toBool();
     if (m_useSolidBackground)
         return;
 
+    connect(m_backgroundWatcher, &QFutureWatcher<QImage>::finished, this, &BoxFrame::onBackgroundLoaded);
+    connect(m_blurBackgroundWatcher, &QFutureWatcher<QImage>::finished, this, &BoxFrame::onBlurBackgroundLoaded);
+
     m_bgManager = new BackgroundManager(this);
     connect(m_bgManager, &BackgroundManager::currentWorkspaceBackgroundChanged, this, &BoxFrame::setBackground);
     connect(m_bgManager, &BackgroundManager::currentWorkspaceBlurBackgroundChanged, this, &BoxFrame::setBlurBackground);
@@ -54,7 +63,7 @@ void BoxFrame::setBlurBackground(const QString &url)
     scaledBlurBackground();
 }
 
-/** 缩放图片并缓存
+/** 在后台线程中按屏幕尺寸解码模糊背景图片, 加载完成前保留上一次的背景
  * @brief BoxFrame::scaledBlurBackground
  */
 void BoxFrame::scaledBlurBackground()
@@ -62,27 +71,10 @@ void BoxFrame::scaledBlurBackground()
     if (m_useSolidBackground)
         return;
 
-    const QSize &size = currentScreen()->size() * currentScreen()->devicePixelRatio();
-    static QString blurBgPath;
-    static QSize lastSize;
-
-    // 当背景图片路径且屏幕大小没有变化，则无需再次加载,减少资源加载耗时
-    if (blurBgPath == m_lastBlurUrl && size == lastSize)
-        return;
-
-    blurBgPath = m_lastBlurUrl;
-    lastSize = size;
-
-    QPixmap pixmap(m_lastBlurUrl);
-    if (pixmap.isNull())
-        pixmap.load(m_defaultBg);
-
-    QPixmap scaledpixmap = pixmap.scaled(size, Qt::KeepAspectRatioByExpanding,
-                                         Qt::SmoothTransformation);
-    emit backgroundImageChanged(scaledpixmap);
+    requestScaledImage(m_blurBackgroundWatcher, m_blurBackgroundKey, m_lastBlurUrl);
 }
 
-/** 缩放图片并缓存
+/** 在后台线程中按屏幕尺寸解码背景图片, 加载完成前保留上一次的背景
  * @brief BoxFrame::scaledBackground
  */
 void BoxFrame::scaledBackground()
@@ -90,35 +82,113 @@ void BoxFrame::scaledBackground()
     if (m_useSolidBackground)
         return;
 
+    requestScaledImage(m_backgroundWatcher, m_backgroundKey, m_lastUrl);
+}
+
+/**
+ * @brief BoxFrame::requestScaledImage 启动后台解码任务, 新任务开始后旧任务的结果不再使用
+ * @param watcher 监视解码任务的对象
+ * @param loadedKey 已加载或正在加载的图片路径及尺寸, 解码失败时在结果回调中清除
+ * @param url 图片路径
+ * @return 启动了新的解码任务时返回 true
+ */
+bool BoxFrame::requestScaledImage(QFutureWatcher<QImage> *watcher, QString &loadedKey, const QString &url)
+{
+    const QSize size = currentScreen()->size() * currentScreen()->devicePixelRatio();
+    const QString key = QString("%1_%2x%3").arg(url).arg(size.width()).arg(size.height());
+
     // 当背景图片路径且屏幕大小没有变化，则无需再次加载,减少资源加载耗时
-    const QSize &size = currentScreen()->size() * currentScreen()->devicePixelRatio();
-    static QString bgPath;
+    if (loadedKey == key)
+        return false;
 
-    if (bgPath == m_lastUrl && m_pixmap.size() == size)
-        return;
+    loadedKey = key;
+
+    const QString defaultBg = m_defaultBg;
+    const QString cacheKey = BackgroundCache::key(url, "scaled", currentScreen()->geometry(), currentScreen()->devicePixelRatio());
+    watcher->setFuture(QtConcurrent::run([url, defaultBg, size, cacheKey] {
+        // 已缓存时直接读取缩放后的图片, 无需再次解码
+        QImage image = BackgroundCache::image(cacheKey);
+        if (!image.isNull())
+            return image;
+
+        // 壁纸无法解码而使用默认背景时不缓存, 避免默认背景记录在该壁纸的缓存键下
+        bool usedFallback = false;
+        image = loadScaledImage(url, defaultBg, size, &usedFallback);
+        if (!usedFallback)
+            BackgroundCache::insertImage(cacheKey, image);
+
+        return image;
+    }));
+
+    return true;
+}
 
-    bgPath = m_lastUrl;
+/**
+ * @brief BoxFrame::loadScaledImage 直接按目标尺寸解码图片, 避免先解码原始分辨率的大图再缩放
+ * @param path 图片路径
+ * @param fallbackPath 图片无法读取时使用的图片路径
+ * @param size 目标尺寸, 按比例扩展填满该尺寸
+ * @param usedFallback 不为空时返回是否使用了备用图片
+ * @return 解码后的图片
+ */
+QImage BoxFrame::loadScaledImage(const QString &path, const QString &fallbackPath, const QSize &size, bool *usedFallback)
+{
+    QImageReader reader(path);
+    const bool fallback = !reader.canRead();
+    if (fallback)
+        reader.setFileName(fallbackPath);
+
+    if (usedFallback)
+        *usedFallback = fallback;
+
+    const QSize imageSize = reader.size();
+    if (imageSize.isValid() && size.isValid())
+        reader.setScaledSize(imageSize.scaled(size, Qt::KeepAspectRatioByExpanding));
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "read background failed:" << reader.fileName() << reader.errorString();
+        return image;
+    }
 
-    QPixmap pixmap(m_lastUrl);
-    if (pixmap.isNull())
-        pixmap = QPixmap(m_defaultBg);
+    // 部分格式不支持解码时缩放
+    if (size.isValid() && image.size() != reader.scaledSize())
+        image = image.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+
+    return image;
+}
+
+void BoxFrame::onBackgroundLoaded()
+{
+    const QImage image = m_backgroundWatcher->result();
+    // 解码失败时清除记录的键值, 下次请求时重新加载
+    if (image.isNull()) {
+        m_backgroundKey.clear();
+        return;
+    }
 
-    m_pixmap = pixmap.scaled(size, Qt::KeepAspectRatioByExpanding,
-                             Qt::SmoothTransformation);
+    m_pixmap = QPixmap::fromImage(image);
     update();
 }
 
-const QScreen *BoxFrame::currentScreen()
+void BoxFrame::onBlurBackgroundLoaded()
 {
-    if (DisplayHelper::instance()->displayMode() == MERGE_MODE)
-        return qApp->primaryScreen();
+    const QImage image = m_blurBackgroundWatcher->result();
+    if (image.isNull()) {
+        m_blurBackgroundKey.clear();
+        return;
+    }
 
-    int screenIndex = QApplication::desktop()->screenNumber(this);
-    QList<QScreen *> screens = qApp->screens();
-    if (screenIndex < screens.count() && screenIndex != -1)
-        return screens[screenIndex];
+    emit backgroundImageChanged(QPixmap::fromImage(image));
+}
+
+const QScreen *BoxFrame::currentScreen()
+{
+    DisplayTopology *topology = DisplayTopology::instance();
+    if (topology->displayMode() == MERGE_MODE)
+        return topology->primaryScreen();
 
-    return qApp->primaryScreen();
+    return topology->screenAt(mapToGlobal(rect().center()));
 }
 
 void BoxFrame::paintEvent(QPaintEvent *event)
@@ -138,7 +208,7 @@ void BoxFrame::paintEvent(QPaintEvent *event)
 void BoxFrame::moveEvent(QMoveEvent *event)
 {
     if (m_bgManager)
-        m_bgManager->updateBlurBackgrounds();
+        m_bgManager->updateScreenBackgrounds();
     QLabel::moveEvent(event);
 }
 
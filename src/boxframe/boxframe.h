@@ -7,6 +7,8 @@
 
 #include <QLabel>
 #include <QPixmapCache>
+#include <QFutureWatcher>
+#include <QImage>
 
 class QPixmap;
 class BackgroundManager;
@@ -35,13 +37,22 @@ protected:
 private:
     virtual const QScreen * currentScreen();
 
+    static QImage loadScaledImage(const QString &path, const QString &fallbackPath, const QSize &size, bool *usedFallback = nullptr);
+    bool requestScaledImage(QFutureWatcher<QImage> *watcher, QString &loadedKey, const QString &url);
+    void onBackgroundLoaded();
+    void onBlurBackgroundLoaded();
+
 private:
     QString m_lastUrl;
     QString m_lastBlurUrl;
     QPixmap m_pixmap;
+    QString m_backgroundKey;                            // 已加载或正在加载的背景图片路径及尺寸
+    QString m_blurBackgroundKey;                        // 已加载或正在加载的模糊背景图片路径及尺寸
     QString m_defaultBg;
     BackgroundManager *m_bgManager;
     bool m_useSolidBackground;
+    QFutureWatcher<QImage> *m_backgroundWatcher;
+    QFutureWatcher<QImage> *m_blurBackgroundWatcher;
 };
 
 #endif // BOXFRAME_H
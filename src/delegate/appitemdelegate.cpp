@@ -27,6 +27,7 @@ AppItemDelegate::AppItemDelegate(QObject *parent)
     , m_calcUtil(CalculateUtil::instance())
     , m_blueDotPixmap(QIcon(":/skin/images/new_install_indicator.svg").pixmap(QSize(10, 10)))
     , m_autoStartPixmap(QIcon(":/skin/images/emblem-autostart.svg").pixmap(QSize(24, 24)))
+    , m_tileCache(32 * 1024)
 {
 }
 
@@ -42,37 +43,223 @@ void AppItemDelegate::setCurrentIndex(const QModelIndex &index)
     emit requestUpdate(CurrentIndex);
 }
 
+bool AppItemDelegate::LayoutKey::operator==(const LayoutKey &other) const
+{
+    return itemSize == other.itemSize && iconSize == other.iconSize && fontPixelSize == other.fontPixelSize
+            && drawBlueDot == other.drawBlueDot && qFuzzyCompare(ratio, other.ratio)
+            && name == other.name && fontKey == other.fontKey;
+}
+
+bool AppItemDelegate::TileKey::operator==(const TileKey &other) const
+{
+    return iconKey == other.iconKey && itemSize == other.itemSize && iconSize == other.iconSize
+            && fontPixelSize == other.fontPixelSize && newInstall == other.newInstall && autoStart == other.autoStart
+            && selected == other.selected && qFuzzyCompare(ratio, other.ratio)
+            && appKey == other.appKey && name == other.name && fontKey == other.fontKey;
+}
+
+uint qHash(const AppItemDelegate::TileKey &key, uint seed)
+{
+    return qHash(key.appKey, seed) ^ qHash(key.iconKey, seed)
+            ^ qHash(key.itemSize.width() << 16 | key.itemSize.height(), seed)
+            ^ qHash(int(key.selected) | int(key.newInstall) << 1 | int(key.autoStart) << 2, seed);
+}
+
+uint qHash(const AppItemDelegate::LayoutKey &key, uint seed)
+{
+    return qHash(key.name, seed) ^ qHash(key.fontKey, seed)
+            ^ qHash(key.itemSize.width() << 16 | key.itemSize.height(), seed)
+            ^ qHash(key.iconSize.width() << 16 | key.iconSize.height(), seed)
+            ^ qHash(key.fontPixelSize << 1 | int(key.drawBlueDot), seed);
+}
+
+/**
+ * @brief AppItemDelegate::itemLayout 获取应用项的布局结果
+ * 布局只与应用名称、项大小、图标大小、字体、设备像素比以及是否绘制小蓝点相关, 计算结果会被缓存,
+ * 翻页和悬停等重绘时不再进行文字测量, 视图命中检测同样使用该结果, 字体统一取自 option.font
+ * @param option 应用项的绘制参数
+ * @param index 应用项的模型索引
+ * @return 以应用项矩形左上角为原点的布局结果
+ */
+const AppItemDelegate::ItemLayout AppItemDelegate::itemLayout(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    return itemLayout(option, index.data(AppsListModel::AppRenderSnapshotRole).value<AppRenderSnapshot>());
+}
+
+const AppItemDelegate::ItemLayout AppItemDelegate::itemLayout(const QStyleOptionViewItem &option, const AppRenderSnapshot &snapshot) const
+{
+    LayoutKey key;
+    key.name = snapshot.name;
+    key.itemSize = option.rect.size();
+    key.iconSize = snapshot.iconSize;
+    key.fontKey = option.font.key();
+    key.fontPixelSize = snapshot.fontPixelSize;
+    key.drawBlueDot = snapshot.newInstall;
+    key.ratio = qApp->devicePixelRatio();
+
+    auto it = m_layoutCache.constFind(key);
+    if (it != m_layoutCache.constEnd())
+        return it.value();
+
+    // 应用名称或布局参数变化后旧的结果不会再被使用, 超出上限时整体清理
+    if (m_layoutCache.size() > 4096)
+        m_layoutCache.clear();
+
+    const ItemLayout layout = calcItemLayout(key, option.font);
+    m_layoutCache.insert(key, layout);
+
+    return layout;
+}
+
 void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
-    if (index.data(AppsListModel::AppItemIsDraggingRole).value<bool>() && !(option.features & QStyleOptionViewItem::HasDisplay))
+    // 一次查询获取绘制所需的全部数据
+    const AppRenderSnapshot snapshot = index.data(AppsListModel::AppRenderSnapshotRole).value<AppRenderSnapshot>();
+    if (snapshot.dragging && !(option.features & QStyleOptionViewItem::HasDisplay))
         return;
 
+    const bool selected = CurrentIndex == index && !(option.features & QStyleOptionViewItem::HasDisplay);
+
+    // 布局、图块与视图命中检测统一使用 option.font, 保证绘制位置与命中区域一致
+    const ItemLayout layout = itemLayout(option, snapshot);
+
+    //分类模式且不是当前的分类就设置透明度
+    if (snapshot.group >= 4 && snapshot.category != m_calcUtil->currentCategory()) {
+        painter->setOpacity(0.3);
+    } else {
+        painter->setOpacity(1);
+    }
+
+    // 图标还未加载完成时直接绘制, 不缓存不完整的图块
+    if (snapshot.icon.isNull()) {
+        painter->setFont(option.font);
+        drawItem(painter, option.rect.topLeft(), snapshot, layout, selected);
+        return;
+    }
+
+    painter->drawPixmap(option.rect.topLeft(), itemTile(option.font, option.rect.size(), snapshot, layout, selected));
+}
+
+/**
+ * @brief AppItemDelegate::itemTile 获取应用项绘制完成的图块
+ * 图块按应用、选中状态、大小、字体和设备像素比缓存, 键值包含图标及各绘制数据,
+ * 模型数据变化后生成新的键值, 旧图块不会再被命中, 由缓存按容量淘汰
+ * @param font 视图字体
+ * @param itemSize 应用项大小
+ * @param snapshot 应用项绘制快照
+ * @param layout 应用项布局
+ * @param selected 是否绘制选中样式
+ * @return 应用项图块
+ */
+const QPixmap AppItemDelegate::itemTile(const QFont &font, const QSize &itemSize, const AppRenderSnapshot &snapshot, const ItemLayout &layout, const bool selected) const
+{
+    const qreal ratio = qApp->devicePixelRatio();
+
+    TileKey key;
+    key.appKey = snapshot.key;
+    key.name = snapshot.name;
+    key.iconKey = snapshot.icon.cacheKey();
+    key.iconSize = snapshot.iconSize;
+    key.itemSize = itemSize;
+    key.fontKey = font.key();
+    key.fontPixelSize = snapshot.fontPixelSize;
+    key.newInstall = snapshot.newInstall;
+    key.autoStart = snapshot.autoStart;
+    key.selected = selected;
+    key.ratio = ratio;
+
+    if (QPixmap *tile = m_tileCache.object(key))
+        return *tile;
+
+    QPixmap tile(itemSize * ratio);
+    tile.setDevicePixelRatio(ratio);
+    tile.fill(Qt::transparent);
+
+    QPainter painter(&tile);
+    painter.setFont(font);
+    drawItem(&painter, QPoint(0, 0), snapshot, layout, selected);
+    painter.end();
+
+    m_tileCache.insert(key, new QPixmap(tile), qMax(1, tile.width() * tile.height() * 4 / 1024));
+
+    return tile;
+}
+
+/**
+ * @brief AppItemDelegate::drawItem 绘制应用项的选中样式、名称、图标以及各标识
+ * @param painter 画笔
+ * @param offset 应用项左上角位置
+ * @param snapshot 应用项绘制快照
+ * @param layout 应用项布局
+ * @param selected 是否绘制选中样式
+ */
+void AppItemDelegate::drawItem(QPainter *painter, const QPoint &offset, const AppRenderSnapshot &snapshot, const ItemLayout &layout, const bool selected) const
+{
     painter->setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
     painter->setPen(Qt::white);
     painter->setBrush(QBrush(Qt::transparent));
 
-#ifdef QT_DEBUG
-    ItemInfo itemInfo = index.data(AppsListModel::AppRawItemInfoRole).value<ItemInfo>();
-#else
-    const ItemInfo itemInfo = index.data(AppsListModel::AppRawItemInfoRole).value<ItemInfo>();
-#endif
-    const int fontPixelSize = index.data(AppsListModel::AppFontSizeRole).value<int>();
-    const bool drawBlueDot = index.data(AppsListModel::AppNewInstallRole).toBool();
-    const bool is_current = CurrentIndex == index;
-    const QRect ibr = itemBoundingRect(option.rect);
-    const QSize iconSize = index.data(AppsListModel::AppIconSizeRole).toSize();
+    const QRect iconRect = layout.iconRect.translated(offset);
 
     // process font
     QFont appNamefont(painter->font());
+    appNamefont.setPixelSize(snapshot.fontPixelSize);
+
+    // 绘制选中样式
+    if (selected) {
+        const int radius = 18;
+        const QColor brushColor(255, 255, 255, 51);
+
+        painter->setPen(Qt::transparent);
+        painter->setBrush(brushColor);
+        painter->drawRoundedRect(layout.selectedRect.translated(offset), radius, radius);
+    }
+
+    // 绘制应用名称
+    QTextOption appNameOption;
+    appNameOption.setAlignment(Qt::AlignHCenter | Qt::AlignTop);
+    appNameOption.setWrapMode(QTextOption::WordWrap);
+
+    const QRectF appNameRect = layout.appNameRect.translated(offset);
+
+    painter->setFont(appNamefont);
+    painter->setBrush(QBrush(Qt::transparent));
+    painter->setPen(QColor(0, 0, 0, 80));
+    painter->drawText(appNameRect.adjusted(0.8, 1, 0.8, 1), layout.appName, appNameOption);
+    painter->drawText(appNameRect.adjusted(-0.8, 1, -0.8, 1), layout.appName, appNameOption);
+    painter->setPen(Qt::white);
+    painter->drawText(appNameRect, layout.appName, appNameOption);
+
+    // draw app icon
+    const QPixmap &iconPix = snapshot.icon;
+    painter->drawPixmap(iconRect, iconPix, iconPix.rect());
+
+    // draw icon if app is auto startup
+    if (snapshot.autoStart)
+        painter->drawPixmap(layout.autoStartPos + offset, m_autoStartPixmap);
+
+    // draw blue dot if needed
+    if (snapshot.newInstall)
+        painter->drawPixmap(layout.blueDotPos + offset, m_blueDotPixmap);
+}
+
+/**
+ * @brief AppItemDelegate::calcItemLayout 计算应用项的布局, 图标和文字区域根据项大小逐步收缩边距直到文字可以完整显示
+ * @param key 布局参数
+ * @param font 视图字体
+ * @return 以应用项矩形左上角为原点的布局结果
+ */
+const AppItemDelegate::ItemLayout AppItemDelegate::calcItemLayout(const LayoutKey &key, const QFont &font) const
+{
+    const int fontPixelSize = key.fontPixelSize;
+    const bool drawBlueDot = key.drawBlueDot;
+    const QRect ibr = itemBoundingRect(QRect(QPoint(0, 0), key.itemSize));
+    const QSize iconSize = key.iconSize;
+
+    // process font
+    QFont appNamefont(font);
     appNamefont.setPixelSize(fontPixelSize);
     const QFontMetrics fm(appNamefont);
-    //分类模式且不是当前的分类就设置透明度
-    if (index.data(AppsListModel::AppGroupRole).toInt() >= 4
-            && index.data(AppsListModel::AppCategoryRole).toInt() != m_calcUtil->currentCategory()) {
-        painter->setOpacity(0.3);
-    } else {
-        painter->setOpacity(1);
-    }
 
     // Curve Fitting Result from MATLAB
 //    const int x = iconSize.width();
@@ -108,7 +295,7 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
 
         // calc text
         appNameRect = itemTextRect(br, iconRect, drawBlueDot);
-        const QPair<QString, bool> appTextResolvedInfo = holdTextInRect(fm, itemInfo.m_name, appNameRect.toRect());
+        const QPair<QString, bool> appTextResolvedInfo = holdTextInRect(fm, key.name, appNameRect.toRect());
         appNameResolved = appTextResolvedInfo.first;
 
         if ((fm.width(appNameResolved) + (drawBlueDot ? (m_blueDotPixmap.width() + 10) : 0)) >= appNameRect.width())
@@ -123,84 +310,53 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
         // we need adjust again!
         adjust = true;
     } while (true);
-//    painter->fillRect(option.rect, Qt::gray);
-//    painter->fillRect(ibr, Qt::cyan);
-//    painter->fillRect(br, Qt::green);
-//    painter->fillRect(appNameRect, Qt::blue);
-//    painter->fillRect(iconRect, Qt::magenta);
-
-    // 绘制选中样式
-   if (is_current && !(option.features & QStyleOptionViewItem::HasDisplay)) {
-        const int radius = 18;
-        const QColor brushColor(255, 255, 255, 51);
 
-        painter->setPen(Qt::transparent);
-        painter->setBrush(brushColor);
-        int drawBlueDotWidth = 0;
-        if (drawBlueDot)
-            drawBlueDotWidth = m_blueDotPixmap.width();
-
-        if (iconSize.width() > (fm.width(appNameResolved) + drawBlueDotWidth)) {
-            br.setX(iconRect.x() - ICONTOLETF);
-            br.setWidth(iconSize.width() + ICONTOLETF * 2);
-        } else {
-            int width = fm.width(appNameResolved) + drawBlueDotWidth + TEXTTOLEFT * 2;
-            if (width < br.width()) {
-                br.setX(br.x() + (br.width() - width) / 2);
-                br.setWidth(width);
-            }
+    ItemLayout layout;
+    layout.iconRect = iconRect;
+    layout.appName = appNameResolved;
+
+    // 选中样式
+    const int appNameWidth = fm.width(appNameResolved);
+    const int drawBlueDotWidth = drawBlueDot ? m_blueDotPixmap.width() : 0;
+    QRect selectedRect = br;
+    if (iconSize.width() > (appNameWidth + drawBlueDotWidth)) {
+        selectedRect.setX(iconRect.x() - ICONTOLETF);
+        selectedRect.setWidth(iconSize.width() + ICONTOLETF * 2);
+    } else {
+        int width = appNameWidth + drawBlueDotWidth + TEXTTOLEFT * 2;
+        if (width < selectedRect.width()) {
+            selectedRect.setX(selectedRect.x() + (selectedRect.width() - width) / 2);
+            selectedRect.setWidth(width);
         }
-
-        painter->drawRoundedRect(br, radius, radius);
     }
+    layout.selectedRect = selectedRect;
 
-    // 绘制应用名称
-    QTextOption appNameOption;
-    appNameOption.setAlignment(Qt::AlignHCenter | Qt::AlignTop);
-    appNameOption.setWrapMode(QTextOption::WordWrap);
-
+    // 应用名称
     appNameRect.setY(br.y() + br.height() - TEXTTOLEFT + (fm.height() >= 28 ? 2 : 0) - fm.height() - fontPixelSize * TextSecond);
 
     if (drawBlueDot) {
         appNameRect.setX(appNameRect.x() + m_blueDotPixmap.width() / 2 + 5);
         appNameRect.setWidth(appNameRect.width() - m_blueDotPixmap.width());
     }
+    layout.appNameRect = appNameRect;
 
-    painter->setFont(appNamefont);
-    painter->setBrush(QBrush(Qt::transparent));
-    painter->setPen(QColor(0, 0, 0, 80));
-    painter->drawText(appNameRect.adjusted(0.8, 1, 0.8, 1), appNameResolved, appNameOption);
-    painter->drawText(appNameRect.adjusted(-0.8, 1, -0.8, 1), appNameResolved, appNameOption);
-    painter->setPen(Qt::white);
-    painter->drawText(appNameRect, appNameResolved, appNameOption);
-
-    // 文字矩形
-    // painter->setPen(QColor(255, 0, 0));
-    // painter->drawRect(appNameRect);
-
-    // draw app icon
-    const QPixmap iconPix = index.data(AppsListModel::AppIconRole).value<QPixmap>();
-    painter->drawPixmap(iconRect, iconPix, iconPix.rect());
-
-    // draw icon if app is auto startup
-    const QPoint autoStartIconPos = iconRect.bottomLeft()
+    // 自启动标识
+    layout.autoStartPos = iconRect.bottomLeft()
             // offset for auto-start mark itself
             - QPoint(m_autoStartPixmap.height(), m_autoStartPixmap.width()) / m_autoStartPixmap.devicePixelRatioF() / 2
             // extra offset
             + QPoint(iconRect.width() / 10, -iconRect.height() / 10);
 
-    if (index.data(AppsListModel::AppAutoStartRole).toBool())
-        painter->drawPixmap(autoStartIconPos, m_autoStartPixmap);
-
-    // draw blue dot if needed
+    // 新安装标识
     if (drawBlueDot) {
         const int marginRight = 2;
         const QRectF textRect = fm.boundingRect(appNameRect.toRect(), Qt::AlignTop | Qt::AlignHCenter | Qt::TextWordWrap, appNameResolved);
         const auto ratio = m_blueDotPixmap.devicePixelRatioF();
-        const QPointF blueDotPos = textRect.topLeft() + QPoint(-m_blueDotPixmap.width() / ratio - marginRight,
-                                                               (fm.height() - m_blueDotPixmap.height() / ratio) / 2);
-        painter->drawPixmap(blueDotPos, m_blueDotPixmap);
+        layout.blueDotPos = textRect.topLeft() + QPoint(-m_blueDotPixmap.width() / ratio - marginRight,
+                                                        (fm.height() - m_blueDotPixmap.height() / ratio) / 2);
     }
+
+    return layout;
 }
 
 QSize AppItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
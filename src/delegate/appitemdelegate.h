@@ -9,18 +9,37 @@
 #include <QModelIndex>
 #include <QStyleOptionViewItem>
 #include <QPainter>
+#include <QHash>
+#include <QCache>
 
 class CalculateUtil;
+struct AppRenderSnapshot;
 class AppItemDelegate : public QAbstractItemDelegate
 {
     Q_OBJECT
 
 public:
+    /**
+     * @brief The ItemLayout struct
+     * 应用项的布局结果, 矩形位置均相对于应用项矩形的左上角
+     */
+    struct ItemLayout {
+        QRect iconRect;             // 应用图标区域
+        QRectF appNameRect;         // 应用名称绘制区域
+        QString appName;            // 省略处理后的应用名称
+        QRect selectedRect;         // 选中样式背景区域
+        QPointF blueDotPos;         // 新安装标识位置
+        QPoint autoStartPos;        // 自启动标识位置
+    };
+
     explicit AppItemDelegate(QObject *parent = nullptr);
 
     void setCurrentIndex(const QModelIndex &index);
     const QModelIndex &currentIndex() const {return CurrentIndex;}
 
+    const ItemLayout itemLayout(const QStyleOptionViewItem &option, const QModelIndex &index) const;
+    const ItemLayout itemLayout(const QStyleOptionViewItem &option, const AppRenderSnapshot &snapshot) const;
+
 
 signals:
     void requestUpdate(const QModelIndex &idx) const;
@@ -30,6 +49,40 @@ protected:
     QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const;
 
 private:
+    struct LayoutKey {
+        QString name;
+        QSize itemSize;
+        QSize iconSize;
+        QString fontKey;
+        int fontPixelSize;
+        bool drawBlueDot;
+        qreal ratio;
+
+        bool operator==(const LayoutKey &other) const;
+    };
+
+    struct TileKey {
+        QString appKey;
+        QString name;
+        qint64 iconKey;
+        QSize iconSize;
+        QSize itemSize;
+        QString fontKey;
+        int fontPixelSize;
+        bool newInstall;
+        bool autoStart;
+        bool selected;
+        qreal ratio;
+
+        bool operator==(const TileKey &other) const;
+    };
+
+    friend uint qHash(const LayoutKey &key, uint seed);
+    friend uint qHash(const TileKey &key, uint seed);
+
+    const ItemLayout calcItemLayout(const LayoutKey &key, const QFont &font) const;
+    const QPixmap itemTile(const QFont &font, const QSize &itemSize, const AppRenderSnapshot &snapshot, const ItemLayout &layout, const bool selected) const;
+    void drawItem(QPainter *painter, const QPoint &offset, const AppRenderSnapshot &snapshot, const ItemLayout &layout, const bool selected) const;
     const QRect itemBoundingRect(const QRect &itemRect) const;
     const QRect itemTextRect(const QRect &boundingRect, const QRect &iconRect, const bool extraWidthMargin) const;
     const QPair<QString, bool> holdTextInRect(const QFontMetrics &fm, const QString &text, const QRect &rect) const;
@@ -38,6 +91,8 @@ private:
     CalculateUtil *m_calcUtil;
     QPixmap m_blueDotPixmap;   // 新安装的app样式
     QPixmap m_autoStartPixmap; // 自启动的app样式
+    mutable QHash<LayoutKey, ItemLayout> m_layoutCache;
+    mutable QCache<TileKey, QPixmap> m_tileCache;   // 绘制完成的应用项图块, 容量单位为KB
 
     static QModelIndex CurrentIndex;
 };
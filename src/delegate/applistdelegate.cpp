@@ -7,6 +7,7 @@
 #include "calculate_util.h"
 #include "util.h"
 #include "iteminfo.h"
+#include "skinassetcache.h"
 
 #include <DGuiApplicationHelper>
 
@@ -26,8 +27,8 @@ AppListDelegate::AppListDelegate(QObject *parent)
       m_actived(false),
       m_calcUtil(CalculateUtil::instance())
 {
-    m_blueDotPixmap = renderSVG(":/skin/images/new_install_indicator.svg", QSize(10, 10));
-    m_autoStartPixmap = renderSVG(":/skin/images/emblem-autostart.svg", QSize(16, 16));
+    m_blueDotPixmap = SkinAssetCache::svg(":/skin/images/new_install_indicator.svg", QSize(10, 10));
+    m_autoStartPixmap = SkinAssetCache::svg(":/skin/images/emblem-autostart.svg", QSize(16, 16));
 
     // 修改背景颜色
     if (DGuiApplicationHelper::DarkType == DGuiApplicationHelper::instance()->themeType()) {
@@ -72,8 +73,8 @@ void AppListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     }
 
     if (isDragItem) {
-        QPixmap dragIndicator = renderSVG(":/widgets/images/drag_indicator.svg",
-                                          QSize(20, 20));
+        const QPixmap dragIndicator = SkinAssetCache::svg(":/widgets/images/drag_indicator.svg",
+                                                          QSize(20, 20));
         painter->drawPixmap(rect.right() - 30,
                             rect.y() + (rect.height() - dragIndicator.height() / ratio) / 2,
                             dragIndicator);
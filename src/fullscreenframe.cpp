@@ -8,6 +8,7 @@
 #include "sharedeventfilter.h"
 #include "constants.h"
 #include "iconcachemanager.h"
+#include "idlemode.h"
 
 #include <QApplication>
 #include <QDesktopWidget>
@@ -19,6 +20,7 @@
 #include <QKeyEvent>
 #include <QProcess>
 #include <QScroller>
+#include <QPainter>
 
 #include <DWindowManagerHelper>
 #include <DDBusSender>
@@ -64,20 +66,10 @@ FullScreenFrame::FullScreenFrame(QWidget *parent) :
   , m_appsItemBox(new DHBoxWidget(m_contentFrame))
   , m_appsItemSeizeBox(new MaskQWidget)
   , m_tipsLabel(new QLabel(this))
+  , m_snapshotLabel(new QLabel(this))
   , m_appItemDelegate(new AppItemDelegate(this))
   , m_multiPagesView(new MultiPagesView(AppsListModel::All, this))
 
-  , m_internetBoxWidget(new BlurBoxWidget(AppsListModel::Internet, const_cast<char *>("Internet"), m_appsItemBox))
-  , m_chatBoxWidget(new BlurBoxWidget(AppsListModel::Chat, const_cast<char *>("Chat"), m_appsItemBox))
-  , m_musicBoxWidget(new BlurBoxWidget(AppsListModel::Music, const_cast<char *>("Music"), m_appsItemBox))
-  , m_videoBoxWidget(new BlurBoxWidget(AppsListModel::Video, const_cast<char *>("Video"), m_appsItemBox))
-  , m_graphicsBoxWidget(new BlurBoxWidget(AppsListModel::Graphics, const_cast<char *>("Graphics"), m_appsItemBox))
-  , m_gameBoxWidget(new BlurBoxWidget(AppsListModel::Game, const_cast<char *>("Games"), m_appsItemBox))
-  , m_officeBoxWidget(new BlurBoxWidget(AppsListModel::Office, const_cast<char *>("Office"), m_appsItemBox))
-  , m_readingBoxWidget(new BlurBoxWidget(AppsListModel::Reading, const_cast<char *>("Reading"), m_appsItemBox))
-  , m_developmentBoxWidget(new BlurBoxWidget(AppsListModel::Development, const_cast<char *>("Development"), m_appsItemBox))
-  , m_systemBoxWidget(new BlurBoxWidget(AppsListModel::System, const_cast<char *>("System"), m_appsItemBox))
-  , m_othersBoxWidget(new BlurBoxWidget(AppsListModel::Others, const_cast<char *>("Other"), m_appsItemBox))
   , m_topSpacing(new QFrame(this))
   , m_bottomSpacing(new QFrame(this))
   , m_animationGroup(new ScrollParallelAnimationGroup(this))
@@ -97,18 +89,8 @@ FullScreenFrame::FullScreenFrame(QWidget *parent) :
     m_navigationWidget->setAccessibleName("navigationWidget");
     m_searchWidget->setAccessibleName("searchWidget");
     m_tipsLabel->setAccessibleName("tipsLabel");
+    m_snapshotLabel->setAccessibleName("snapshotLabel");
     m_appItemDelegate->setObjectName("appItemDelegate");
-    m_internetBoxWidget->setAccessibleName("internetBoxWidget");
-    m_chatBoxWidget->setAccessibleName("chatBoxWidget");
-    m_musicBoxWidget->setAccessibleName("musicBoxWidget");
-    m_videoBoxWidget->setAccessibleName("videoBoxWidget");
-    m_graphicsBoxWidget->setAccessibleName("graphicsBoxWidget");
-    m_gameBoxWidget->setAccessibleName("gameBoxWidget");
-    m_officeBoxWidget->setAccessibleName("officeBoxWidget");
-    m_readingBoxWidget->setAccessibleName("readingBoxWidget");
-    m_developmentBoxWidget->setAccessibleName("developmentBoxWidget");
-    m_systemBoxWidget->setAccessibleName("systemBoxWidget");
-    m_othersBoxWidget->setAccessibleName("othersBoxWidget");
     m_searchWidget->categoryBtn()->setAccessibleName("search_categoryBtn");
     m_contentFrame->setAccessibleName("ContentFrame");
     m_searchWidget->edit()->setAccessibleName("FullScreenSearchEdit");
@@ -157,11 +139,6 @@ FullScreenFrame::FullScreenFrame(QWidget *parent) :
     installEventFilter(m_eventFilter);
 
     connect(m_multiPagesView, &MultiPagesView::connectViewEvent, this, &FullScreenFrame::addViewEvent);
-    for (int i = AppsListModel::Internet; i <= AppsListModel::Others; i++) {
-        AppsListModel::AppCategory appCategory = AppsListModel::AppCategory(i);
-        MultiPagesView *multiPagesView = getCategoryGridViewList(appCategory);
-        connect(multiPagesView, &MultiPagesView::connectViewEvent, this, &FullScreenFrame::addViewEvent);
-    }
 
     // 全屏分类模式下共用这5个控件
     for (int i = 0; i < 5; i++) {
@@ -584,15 +561,6 @@ void FullScreenFrame::keyPressEvent(QKeyEvent *e)
 
 void FullScreenFrame::showEvent(QShowEvent *e)
 {
-    // 显示后加载当前模式其他ratio的资源，预加载全屏另一种模式当前ratio的资源
-    if (m_calcUtil->displayMode() == GROUP_BY_CATEGORY) {
-        emit m_appsManager->loadOtherRatioIcon(GROUP_BY_CATEGORY);
-        emit m_appsManager->loadCurRationIcon(ALL_APPS);
-    } else {
-        emit m_appsManager->loadOtherRatioIcon(ALL_APPS);
-        emit m_appsManager->loadCurRationIcon(GROUP_BY_CATEGORY);
-    }
-
     m_delayHideTimer->stop();
     m_searchWidget->clearSearchContent();
 
@@ -602,7 +570,11 @@ void FullScreenFrame::showEvent(QShowEvent *e)
     if (!m_appsManager->isVaild())
         m_appsManager->refreshAllList();
 
-    updateDockPosition();
+    // 有快照覆盖时, 待快照呈现到屏幕后再处理耗时的布局和资源加载, 保证第一帧尽快显示
+    if (!m_snapshotLabel->isHidden())
+        m_showWorkPending = true;
+    else
+        doShowWork();
 
     QFrame::showEvent(e);
 
@@ -618,6 +590,25 @@ void FullScreenFrame::showEvent(QShowEvent *e)
     m_canResizeDockPosition = true;
 }
 
+/**
+ * @brief FullScreenFrame::doShowWork 显示时调整各部件位置, 并加载其他ratio及另一种模式的图标资源
+ */
+void FullScreenFrame::doShowWork()
+{
+    m_showWorkPending = false;
+
+    // 显示后加载当前模式其他ratio的资源，预加载全屏另一种模式当前ratio的资源
+    if (m_calcUtil->displayMode() == GROUP_BY_CATEGORY) {
+        emit m_appsManager->loadOtherRatioIcon(GROUP_BY_CATEGORY);
+        emit m_appsManager->loadCurRationIcon(ALL_APPS);
+    } else {
+        emit m_appsManager->loadOtherRatioIcon(ALL_APPS);
+        emit m_appsManager->loadCurRationIcon(GROUP_BY_CATEGORY);
+    }
+
+    updateDockPosition();
+}
+
 void FullScreenFrame::hideEvent(QHideEvent *e)
 {
     BoxFrame::hideEvent(e);
@@ -770,6 +761,9 @@ bool FullScreenFrame::eventFilter(QObject *o, QEvent *e)
         }
     } else if (o == m_contentFrame && e->type() == QEvent::Resize && m_canResizeDockPosition) {
         updateDockPosition();
+    } else if (o == m_snapshotLabel && e->type() == QEvent::Paint) {
+        // 快照已呈现到屏幕, 下一轮事件循环时再处理显示时的耗时操作, 完成后移除快照
+        QTimer::singleShot(0, this, &FullScreenFrame::finishHideSnapshot);
     }
 
     return false;
@@ -808,6 +802,12 @@ void FullScreenFrame::initUI()
     m_tipsLabel->setFixedSize(500, 50);
     m_tipsLabel->setVisible(false);
 
+    m_snapshotLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+    // 快照完全覆盖下方界面, 避免下方控件随快照一同重绘
+    m_snapshotLabel->setAttribute(Qt::WA_OpaquePaintEvent);
+    m_snapshotLabel->setVisible(false);
+    m_snapshotLabel->installEventFilter(this);
+
     m_delayHideTimer->setInterval(500);
     m_delayHideTimer->setSingleShot(true);
 
@@ -831,18 +831,6 @@ void FullScreenFrame::initUI()
 
     setBlurWidgetVisible(false);
 
-    m_internetBoxWidget->setDataDelegate(m_appItemDelegate);
-    m_chatBoxWidget->setDataDelegate(m_appItemDelegate);
-    m_musicBoxWidget->setDataDelegate(m_appItemDelegate);
-    m_videoBoxWidget->setDataDelegate(m_appItemDelegate);
-    m_graphicsBoxWidget->setDataDelegate(m_appItemDelegate);
-    m_gameBoxWidget->setDataDelegate(m_appItemDelegate);
-    m_officeBoxWidget->setDataDelegate(m_appItemDelegate);
-    m_readingBoxWidget->setDataDelegate(m_appItemDelegate);
-    m_developmentBoxWidget->setDataDelegate(m_appItemDelegate);
-    m_systemBoxWidget->setDataDelegate(m_appItemDelegate);
-    m_othersBoxWidget->setDataDelegate(m_appItemDelegate);
-
     m_appsItemBox->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
     m_appsItemBox->layout()->setMargin(0);
     m_appsItemBox->layout()->setSpacing(0);
@@ -906,32 +894,73 @@ MultiPagesView *FullScreenFrame::getCategoryGridViewList(const AppsListModel::Ap
 
 /**
  * @brief FullScreenFrame::getCategoryBoxWidget
- * 获取当前分类应用对应的控件
+ * 获取当前分类应用对应的控件, 分类控件在第一次使用时才创建
  * @param category 应用分类类型
  * @return 分类控件
  */
-BlurBoxWidget *FullScreenFrame::getCategoryBoxWidget(const AppsListModel::AppCategory category) const
+BlurBoxWidget *FullScreenFrame::getCategoryBoxWidget(const AppsListModel::AppCategory category)
 {
-    BlurBoxWidget *view = nullptr;
+    AppsListModel::AppCategory boxCategory = category;
+    if (boxCategory < AppsListModel::Internet || boxCategory > AppsListModel::Others)
+        boxCategory = AppsListModel::Internet;
 
-    switch (category) {
-    case AppsListModel::Internet:       view = m_internetBoxWidget;      break;
-    case AppsListModel::Chat:           view = m_chatBoxWidget;          break;
-    case AppsListModel::Music:          view = m_musicBoxWidget;         break;
-    case AppsListModel::Video:          view = m_videoBoxWidget;         break;
-    case AppsListModel::Graphics:       view = m_graphicsBoxWidget;      break;
-    case AppsListModel::Game:           view = m_gameBoxWidget;          break;
-    case AppsListModel::Office:         view = m_officeBoxWidget;        break;
-    case AppsListModel::Reading:        view = m_readingBoxWidget;       break;
-    case AppsListModel::Development:    view = m_developmentBoxWidget;   break;
-    case AppsListModel::System:         view = m_systemBoxWidget;        break;
-    case AppsListModel::Others:         view = m_othersBoxWidget;        break;
-    default:                            view = m_internetBoxWidget;      break;
-    }
+    BlurBoxWidget *view = m_categoryBoxWidgets.value(boxCategory, nullptr);
+    if (!view)
+        view = createCategoryBoxWidget(boxCategory);
 
     return view;
 }
 
+/**
+ * @brief FullScreenFrame::createCategoryBoxWidget 创建分类应用对应的控件
+ * @param category 应用分类类型
+ * @return 分类控件
+ */
+BlurBoxWidget *FullScreenFrame::createCategoryBoxWidget(const AppsListModel::AppCategory category)
+{
+    const char *name = nullptr;
+    QString accessibleName;
+
+    switch (category) {
+    case AppsListModel::Internet:       name = "Internet";      accessibleName = "internetBoxWidget";       break;
+    case AppsListModel::Chat:           name = "Chat";          accessibleName = "chatBoxWidget";           break;
+    case AppsListModel::Music:          name = "Music";         accessibleName = "musicBoxWidget";          break;
+    case AppsListModel::Video:          name = "Video";         accessibleName = "videoBoxWidget";          break;
+    case AppsListModel::Graphics:       name = "Graphics";      accessibleName = "graphicsBoxWidget";       break;
+    case AppsListModel::Game:           name = "Games";         accessibleName = "gameBoxWidget";           break;
+    case AppsListModel::Office:         name = "Office";        accessibleName = "officeBoxWidget";         break;
+    case AppsListModel::Reading:        name = "Reading";       accessibleName = "readingBoxWidget";        break;
+    case AppsListModel::Development:    name = "Development";   accessibleName = "developmentBoxWidget";    break;
+    case AppsListModel::System:         name = "System";        accessibleName = "systemBoxWidget";         break;
+    default:                            name = "Other";         accessibleName = "othersBoxWidget";         break;
+    }
+
+    BlurBoxWidget *boxWidget = new BlurBoxWidget(category, const_cast<char *>(name), m_appsItemBox);
+    boxWidget->setAccessibleName(accessibleName);
+    boxWidget->setVisible(false);
+    m_categoryBoxWidgets.insert(category, boxWidget);
+
+    connect(boxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
+    connect(boxWidget->getMultiPagesView(), &MultiPagesView::connectViewEvent, this, &FullScreenFrame::addViewEvent);
+
+    boxWidget->setDataDelegate(m_appItemDelegate);
+
+    // 界面布局完成后创建的控件直接使用当前的分类控件大小
+    const QSize boxSize = categoryBoxSize();
+    if (boxSize.isValid() && !boxSize.isEmpty())
+        boxWidget->setFixedSize(boxSize);
+
+    return boxWidget;
+}
+
+/**
+ * @brief FullScreenFrame::categoryBoxSize 分类模式下单个分类控件的大小
+ */
+QSize FullScreenFrame::categoryBoxSize() const
+{
+    return QSize(m_calcUtil->getAppBoxSize().width(), m_contentFrame->height() - DLauncher::APPS_AREA_TOP_MARGIN);
+}
+
 void FullScreenFrame::checkCurrentCategoryVisible()
 {
     AppsListModel::AppCategory tmpCategory = m_currentCategory;
@@ -1113,6 +1142,10 @@ int FullScreenFrame::nearestCategory(const AppsListModel::AppCategory oldCategor
 void FullScreenFrame::initConnection()
 {
     connect(m_calcUtil, &CalculateUtil::layoutChanged, this, &FullScreenFrame::layoutChanged, Qt::QueuedConnection);
+    // 网格行列数变化后各模型按新的每页数量重新分页, 页面按新的页数增减
+    connect(m_calcUtil, &CalculateUtil::pageItemCountChanged, this, [ this ] {
+        emit m_appsManager->dataChanged(AppsListModel::All);
+    }, Qt::QueuedConnection);
 
     connect(m_navigationWidget, &NavigationWidget::scrollToCategory, this, &FullScreenFrame::scrollToCategory);
 
@@ -1124,18 +1157,6 @@ void FullScreenFrame::initConnection()
     connect(m_searchWidget, &SearchWidget::searchTextChanged, this, &FullScreenFrame::searchTextChanged);
     connect(m_delayHideTimer, &QTimer::timeout, this, &FullScreenFrame::hideLauncher, Qt::QueuedConnection);
 
-    connect(m_internetBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-    connect(m_chatBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-    connect(m_musicBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-    connect(m_videoBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-    connect(m_graphicsBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-    connect(m_gameBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-    connect(m_officeBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-    connect(m_readingBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-    connect(m_developmentBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-    connect(m_systemBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-    connect(m_othersBoxWidget, &BlurBoxWidget::maskClick, this, &FullScreenFrame::blurBoxWidgetMaskClick);
-
     connect(this, &BoxFrame::backgroundImageChanged, &BlurBoxWidget::updateBackgroundImage);
 
     connect(m_menuWorker.get(), &MenuWorker::appLaunched, this, &FullScreenFrame::hideLauncher);
@@ -1161,12 +1182,29 @@ void FullScreenFrame::initConnection()
     connect(m_appsManager, &AppsManager::categoryListChanged, this, &FullScreenFrame::categoryListChanged);
     connect(m_appsManager, &AppsManager::requestTips, this, &FullScreenFrame::showTips);
     connect(m_appsManager, &AppsManager::requestHideTips, this, &FullScreenFrame::hideTips);
-    connect(m_appsManager, &AppsManager::IconSizeChanged, this, &FullScreenFrame::updateDockPosition);
+    // 隐藏期间不调整布局, 显示时 showEvent 中会重新计算
+    connect(m_appsManager, &AppsManager::IconSizeChanged, this, [ this ] {
+        if (!IdleMode::instance()->isIdle())
+            updateDockPosition();
+    });
     connect(m_appsManager, &AppsManager::dataChanged, this, &FullScreenFrame::refreshPageView);
 
+    // 隐藏时的快照依赖的数据发生变化后, 快照失效
+    auto catalogChanged = [ this ] { ++m_catalogVersion; };
+    auto backgroundChanged = [ this ] { ++m_backgroundVersion; };
+    connect(m_appsManager, &AppsManager::dataChanged, this, catalogChanged);
+    connect(m_appsManager, &AppsManager::layoutChanged, this, catalogChanged);
+    connect(m_appsManager, &AppsManager::itemDataChanged, this, catalogChanged);
+    connect(m_appsManager, &AppsManager::categoryListChanged, this, catalogChanged);
+    connect(m_calcUtil, &CalculateUtil::layoutChanged, this, catalogChanged);
+    connect(IconCacheManager::instance(), &IconCacheManager::iconsLoaded, this, catalogChanged);
+    connect(this, &BoxFrame::backgroundImageChanged, this, backgroundChanged);
+    connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, this, backgroundChanged);
+
     connect(m_curScreen, &QScreen::geometryChanged, this, &FullScreenFrame::onScreenInfoChange);
     connect(m_curScreen, &QScreen::orientationChanged, this, &FullScreenFrame::onScreenInfoChange);
     connect(qApp, &QApplication::primaryScreenChanged, this, &FullScreenFrame::onScreenInfoChange);
+    connect(IdleMode::instance(), &IdleMode::idleChanged, this, &FullScreenFrame::onIdleChanged);
 }
 
 void FullScreenFrame::showLauncher()
@@ -1174,6 +1212,11 @@ void FullScreenFrame::showLauncher()
     m_focusIndex = 1;
     m_appItemDelegate->setCurrentIndex(QModelIndex());
 
+    // 快照需在界面刷新前判断是否仍有效
+    const bool useSnapshot = isHideSnapshotValid();
+    if (!useSnapshot)
+        releaseHideSnapshot();
+
     // 启动器跟随任务栏位置
     updateGeometry();
 
@@ -1187,6 +1230,10 @@ void FullScreenFrame::showLauncher()
     m_searchWidget->edit()->lineEdit()->clearFocus();
 
     setFixedSize(m_appsManager->currentScreen()->geometry().size());
+
+    if (useSnapshot)
+        showHideSnapshot();
+
     show();
 }
 
@@ -1195,10 +1242,95 @@ void FullScreenFrame::hideLauncher()
     if (!isVisible())
         return;
 
+    // 搜索状态下的画面与再次显示时的界面不一致, 不保留快照
+    if (m_displayMode != SEARCH)
+        captureHideSnapshot();
+    else
+        releaseHideSnapshot();
+
     m_searchWidget->clearSearchContent();
     hide();
 }
 
+/**
+ * @brief FullScreenFrame::captureHideSnapshot 隐藏前截取当前界面, 记录截取时的数据版本和几何信息
+ */
+void FullScreenFrame::captureHideSnapshot()
+{
+    // 再次显示时不保留选中状态, 截图前清除
+    m_appItemDelegate->setCurrentIndex(QModelIndex());
+    m_snapshotLabel->hide();
+    // 隐藏后不再需要处理显示时推迟的操作, 下次显示时重新处理
+    m_showWorkPending = false;
+
+    // 窗口背景可能带透明度, 合成到不透明的底色上, 保证覆盖时完全遮挡下方界面
+    const QPixmap frame = grab();
+    QPixmap snapshot(frame.size());
+    snapshot.setDevicePixelRatio(frame.devicePixelRatio());
+    snapshot.fill(Qt::black);
+    QPainter painter(&snapshot);
+    painter.drawPixmap(0, 0, frame);
+    painter.end();
+
+    m_hideSnapshot.pixmap = snapshot;
+    m_hideSnapshot.catalogVersion = m_catalogVersion;
+    m_hideSnapshot.backgroundVersion = m_backgroundVersion;
+    m_hideSnapshot.geometry = m_appsManager->currentScreen()->geometry();
+    m_hideSnapshot.ratio = devicePixelRatioF();
+    m_hideSnapshot.displayMode = m_calcUtil->displayMode();
+}
+
+/**
+ * @brief FullScreenFrame::isHideSnapshotValid 判断隐藏时的快照是否与当前状态一致
+ * @return 应用数据、背景、屏幕几何、缩放以及显示模式均未变化时返回 true
+ */
+bool FullScreenFrame::isHideSnapshotValid() const
+{
+    if (m_hideSnapshot.pixmap.isNull() || !m_appsManager->isVaild())
+        return false;
+
+    return m_hideSnapshot.catalogVersion == m_catalogVersion
+            && m_hideSnapshot.backgroundVersion == m_backgroundVersion
+            && m_hideSnapshot.geometry == m_appsManager->currentScreen()->geometry()
+            && qFuzzyCompare(m_hideSnapshot.ratio, devicePixelRatioF())
+            && m_hideSnapshot.displayMode == m_calcUtil->displayMode();
+}
+
+/**
+ * @brief FullScreenFrame::showHideSnapshot 将快照覆盖在界面最上层, 窗口显示的第一帧即为隐藏前的画面
+ */
+void FullScreenFrame::showHideSnapshot()
+{
+    m_snapshotLabel->setPixmap(m_hideSnapshot.pixmap);
+    m_snapshotLabel->setGeometry(rect());
+    m_snapshotLabel->show();
+    m_snapshotLabel->raise();
+}
+
+/**
+ * @brief FullScreenFrame::finishHideSnapshot 快照已呈现, 处理显示时推迟的操作后移除快照
+ */
+void FullScreenFrame::finishHideSnapshot()
+{
+    if (m_snapshotLabel->isHidden())
+        return;
+
+    if (m_showWorkPending)
+        doShowWork();
+
+    releaseHideSnapshot();
+}
+
+/**
+ * @brief FullScreenFrame::releaseHideSnapshot 移除覆盖的快照并释放图片
+ */
+void FullScreenFrame::releaseHideSnapshot()
+{
+    m_snapshotLabel->hide();
+    m_snapshotLabel->clear();
+    m_hideSnapshot.pixmap = QPixmap();
+}
+
 bool FullScreenFrame::visible()
 {
     return isVisible();
@@ -1444,13 +1576,18 @@ void FullScreenFrame::showPopupMenu(const QPoint &pos, const QModelIndex &contex
 
 void FullScreenFrame::uninstallApp(const QString &appKey)
 {
+    QModelIndex index;
     if(m_displayMode != GROUP_BY_CATEGORY){
         int currentPage = m_multiPagesView->currentPage();
-        uninstallApp(m_multiPagesView->pageModel(currentPage)->indexAt(appKey));
+        index = m_multiPagesView->pageModel(currentPage)->indexAt(appKey);
      }else {
         int currentPage =  getCategoryBoxWidget(m_currentCategory)->getMultiPagesView()->currentPage();
-        uninstallApp(getCategoryBoxWidget(m_currentCategory)->getMultiPagesView()->pageModel(currentPage)->indexAt(appKey));
+        index = getCategoryBoxWidget(m_currentCategory)->getMultiPagesView()->pageModel(currentPage)->indexAt(appKey);
      }
+
+    // 应用不在当前页面时不弹出卸载确认框
+    if (index.isValid())
+        uninstallApp(index);
 }
 
 void FullScreenFrame::uninstallApp(const QModelIndex &context)
@@ -1489,6 +1626,12 @@ void FullScreenFrame::uninstallApp(const QModelIndex &context)
 
 void FullScreenFrame::refreshPageView(AppsListModel::AppCategory category)
 {
+    // 隐藏期间只记录, 显示前统一刷新
+    if (IdleMode::instance()->isIdle()) {
+        m_pageViewPending = true;
+        return;
+    }
+
     if (AppsListModel::Search == category) {
         m_multiPagesView->ShowPageView(AppsListModel::AppCategory(m_displayMode));
     } else {
@@ -1497,9 +1640,10 @@ void FullScreenFrame::refreshPageView(AppsListModel::AppCategory category)
     }
 
     if (m_calcUtil->displayMode() == GROUP_BY_CATEGORY) {
-        for (int i = AppsListModel::Internet; i <= AppsListModel::Others; i++) {
-            MultiPagesView *pageView = getCategoryGridViewList(AppsListModel::AppCategory(i));
-            pageView->updatePageCount(AppsListModel::AppCategory(i));
+        // 只刷新已经创建的分类控件, 其余分类在显示时创建
+        for (BlurBoxWidget *boxWidget : m_categoryBoxWidgets) {
+            MultiPagesView *pageView = boxWidget->getMultiPagesView();
+            pageView->updatePageCount(boxWidget->category());
             pageView->showCurrentPage(pageView->currentPage());
         }
 
@@ -1511,6 +1655,11 @@ void FullScreenFrame::refreshPageView(AppsListModel::AppCategory category)
 
 void FullScreenFrame::onScreenInfoChange()
 {
+    if (IdleMode::instance()->isIdle()) {
+        m_screenInfoPending = true;
+        return;
+    }
+
     m_curScreen->disconnect();
     m_curScreen = m_appsManager->currentScreen();
 
@@ -1523,6 +1672,26 @@ void FullScreenFrame::onScreenInfoChange()
     connect(m_curScreen, &QScreen::orientationChanged, this, &FullScreenFrame::onScreenInfoChange);
 }
 
+/**
+ * @brief FullScreenFrame::onIdleChanged 退出空闲状态时处理隐藏期间记录的屏幕变化和页面刷新
+ * @param idle 是否处于空闲状态
+ */
+void FullScreenFrame::onIdleChanged(bool idle)
+{
+    if (idle)
+        return;
+
+    if (m_screenInfoPending) {
+        m_screenInfoPending = false;
+        onScreenInfoChange();
+    }
+
+    if (m_pageViewPending) {
+        m_pageViewPending = false;
+        refreshPageView(AppsListModel::All);
+    }
+}
+
 /**
  * @brief FullScreenFrame::updateDisplayMode 处理全屏模式切换
  * @param mode 全屏自由模式或者全屏分类模式
@@ -1682,17 +1851,8 @@ void FullScreenFrame::nextTabWidget(int key)
 
 void FullScreenFrame::setBlurWidgetVisible(bool state)
 {
-    m_internetBoxWidget->setVisible(state);
-    m_chatBoxWidget->setVisible(state);
-    m_musicBoxWidget->setVisible(state);
-    m_videoBoxWidget->setVisible(state);
-    m_graphicsBoxWidget->setVisible(state);
-    m_gameBoxWidget->setVisible(state);
-    m_officeBoxWidget->setVisible(state);
-    m_readingBoxWidget->setVisible(state);
-    m_developmentBoxWidget->setVisible(state);
-    m_systemBoxWidget->setVisible(state);
-    m_othersBoxWidget->setVisible(state);
+    for (BlurBoxWidget *boxWidget : m_categoryBoxWidgets)
+        boxWidget->setVisible(state);
 }
 
 /**
@@ -1746,7 +1906,7 @@ void FullScreenFrame::mouseReleaseDrag(QMouseEvent *e)
        int nScroll = m_multiPagesView->getListArea()->horizontalScrollBar()->value();
         //多个分页是点击直接隐藏
         if (nScroll == m_scrollStart && curPage != 1)
-            emit m_multiPagesView->getAppGridViewList()[curPage]->clicked(QModelIndex());
+            emit m_multiPagesView->pageView(curPage)->clicked(QModelIndex());
         else if (nScroll - m_scrollStart > DLauncher::MOUSE_MOVE_TO_NEXT)
             m_multiPagesView->showCurrentPage(curPage + 1);
         else if (nScroll - m_scrollStart < -DLauncher::MOUSE_MOVE_TO_NEXT)
@@ -1812,14 +1972,10 @@ void FullScreenFrame::layoutChanged()
         m_appsItemSeizeBox->setFixedSize(boxSize);
         m_appsItemBox->setFixedSize(boxSize);
 
-        boxSize.setWidth(m_calcUtil->getAppBoxSize().width());
-        boxSize.setHeight(boxSize.height());
-
-        for (int i = AppsListModel::Internet; i <= AppsListModel::Others; i++) {
-            AppsListModel::AppCategory appCategory = AppsListModel::AppCategory(i);
-            BlurBoxWidget * boxWidget = getCategoryBoxWidget(appCategory);
-            getCategoryGridViewList(AppsListModel::AppCategory(i))->updatePageCount(AppsListModel::AppCategory(i));
-            boxWidget->setFixedSize(boxSize);
+        // 只更新已经创建的分类控件, 其余分类在显示时按当前大小创建
+        for (BlurBoxWidget *boxWidget : m_categoryBoxWidgets) {
+            boxWidget->getMultiPagesView()->updatePageCount(boxWidget->category());
+            boxWidget->setFixedSize(categoryBoxSize());
         }
 
         checkCurrentCategoryVisible();
@@ -32,6 +32,7 @@
 #include <QPropertyAnimation>
 #include <QSettings>
 #include <QTimer>
+#include <QMap>
 
 #include <memory>
 
@@ -129,11 +130,14 @@ private slots:
     void searchTextChanged(const QString &keywords, bool enableUpdateMode);
     void refreshPageView(const AppsListModel::AppCategory category);
     void onScreenInfoChange();
+    void onIdleChanged(bool idle);
 
 private:
     CategoryTitleWidget *categoryTitle(const AppsListModel::AppCategory category) const;
     MultiPagesView *getCategoryGridViewList(const AppsListModel::AppCategory category);
-    BlurBoxWidget  *getCategoryBoxWidget(const AppsListModel::AppCategory category) const;
+    BlurBoxWidget  *getCategoryBoxWidget(const AppsListModel::AppCategory category);
+    BlurBoxWidget  *createCategoryBoxWidget(const AppsListModel::AppCategory category);
+    QSize categoryBoxSize() const;
 
     void checkCurrentCategoryVisible();
     void showCategoryBoxWidget(AppsListModel::AppCategory appCategory);
@@ -145,6 +149,13 @@ private:
     bool isScrolling();
     void doScrolling();
 
+    void captureHideSnapshot();
+    bool isHideSnapshotValid() const;
+    void showHideSnapshot();
+    void finishHideSnapshot();
+    void releaseHideSnapshot();
+    void doShowWork();
+
 private:
     bool m_isConfirmDialogShown = false;
     int m_displayMode = SEARCH;
@@ -178,21 +189,12 @@ private:
     QHBoxLayout *m_iconHLayout;
 
     QLabel *m_tipsLabel;
+    QLabel *m_snapshotLabel;                            // 再次显示时覆盖在界面上的隐藏前画面
 
     AppItemDelegate *m_appItemDelegate;                 // 全屏模式下listview视图代理
     MultiPagesView *m_multiPagesView;                   // 全屏视图控件类（listview + 分页控件））
 
-    BlurBoxWidget *m_internetBoxWidget;                 // 全屏应用分类下网络应用控件
-    BlurBoxWidget *m_chatBoxWidget;                     // 全屏应用分类下社交沟通控件
-    BlurBoxWidget *m_musicBoxWidget;                    // 全屏应用分类下音乐欣赏控件
-    BlurBoxWidget *m_videoBoxWidget;                    // 全屏应用分类下视频播放控件
-    BlurBoxWidget *m_graphicsBoxWidget;                 // 全屏应用分类下图形图像控件
-    BlurBoxWidget *m_gameBoxWidget;                     // 全屏应用分类下游戏娱乐控件
-    BlurBoxWidget *m_officeBoxWidget;                   // 全屏应用分类下办公学习控件
-    BlurBoxWidget *m_readingBoxWidget;                  // 全屏应用分类下阅读翻译控件
-    BlurBoxWidget *m_developmentBoxWidget;              // 全屏应用分类下编程开发控件
-    BlurBoxWidget *m_systemBoxWidget;                   // 全屏应用分类下系统管理控件
-    BlurBoxWidget *m_othersBoxWidget;                   // 全屏应用分类下其他分类控件
+    QMap<AppsListModel::AppCategory, BlurBoxWidget *> m_categoryBoxWidgets;   // 全屏应用分类下各分类控件, 第一次显示时创建
 
     QFrame *m_topSpacing;
     QFrame *m_bottomSpacing;
@@ -201,6 +203,7 @@ private:
     ScrollParallelAnimationGroup *m_animationGroup;
 
     bool m_canResizeDockPosition = false;               // 只有窗口在完全显示出来后，才允许自动调整各部件位置
+    bool m_showWorkPending = false;                     // 快照覆盖期间推迟的显示处理, 快照呈现后执行
 
     bool m_bMousePress;                                 // 鼠标按下标识
     int m_nMousePos;                                    // 鼠标按住的起始坐标
@@ -209,5 +212,26 @@ private:
     QTime *m_changePageDelayTime;                       // 滚动延时，设定时间内只允许滚动一次
     const QScreen *m_curScreen;
     bool m_bMenuDisplayState;
+
+    /**
+     * @brief The HideSnapshot struct
+     * 隐藏时截取的最后一帧画面, 以及截取时的应用数据版本、背景版本和几何信息,
+     * 再次显示时若这些信息均未变化则先展示该画面, 真实界面在其下方完成刷新
+     */
+    struct HideSnapshot {
+        QPixmap pixmap;
+        quint64 catalogVersion = 0;
+        quint64 backgroundVersion = 0;
+        QRect geometry;
+        qreal ratio = 1.0;
+        int displayMode = ALL_APPS;
+    };
+
+    HideSnapshot m_hideSnapshot;
+    quint64 m_catalogVersion = 0;                       // 应用列表、图标及布局变化时递增
+    quint64 m_backgroundVersion = 0;                    // 背景图片及主题变化时递增
+
+    bool m_pageViewPending = false;                     // 隐藏期间记录的页面刷新, 显示前处理
+    bool m_screenInfoPending = false;                   // 隐藏期间记录的屏幕变化, 显示前处理
 };
 #endif // MAINFRAME_H
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "calculate_util.h"
+#include "displaytopology.h"
 #include "util.h"
 #include "constants.h"
 
@@ -32,36 +33,83 @@ CalculateUtil *CalculateUtil::instance()
  */
 void CalculateUtil::setDisplayMode(const int mode)
 {
-    if (m_launcherGsettings)
-        m_launcherGsettings->set(DisplayModeKey, mode == ALL_APPS ? DisplayModeFree : DisplayModeCategory);
+    if (!m_launcherGsettings)
+        return;
+
+    m_launcherGsettings->set(DisplayModeKey, mode == ALL_APPS ? DisplayModeFree : DisplayModeCategory);
+
+    LayoutMetrics metrics = m_metrics;
+    metrics.displayMode = (mode == ALL_APPS) ? ALL_APPS : GROUP_BY_CATEGORY;
+    setMetrics(metrics);
+}
+
+/**
+ * @brief CalculateUtil::calculateIconSize 获取全屏两种模式下应用图标的实际大小, 结果在布局参数快照中
+ * @param mode 全屏自由模式或者全屏分类模式的标识
+ * @return 返回对应模式下应用的实际大小
+ */
+int CalculateUtil::calculateIconSize(const int mode) const
+{
+    QReadLocker locker(&m_metricsLock);
+    return m_metrics.iconSizes[mode == GROUP_BY_CATEGORY ? GROUP_BY_CATEGORY : ALL_APPS];
 }
 
 /**
  * @brief CalculateUtil::calculateIconSize 计算全屏两种模式下应用图标的实际大小
+ * @param metrics 屏幕相关的布局参数, 其中包含按模式选取的网格行列数
  * @param mode 全屏自由模式或者全屏分类模式的标识
  * @return 返回对应模式下应用的实际大小
  */
-int CalculateUtil::calculateIconSize(int mode)
+int CalculateUtil::calculateIconSize(const LayoutMetrics &metrics, const int mode) const
+{
+    const int index = (mode == GROUP_BY_CATEGORY) ? GROUP_BY_CATEGORY : ALL_APPS;
+    const QSize containerSize = gridContainerSize(metrics, index);
+
+    // 默认边距保留最小５像素
+    int appMarginLeft = 5;
+    int appMarginTop = 5;
+
+    // 去除默认边距后，计算每个Item区域的宽高
+    int perItemWidth  = (containerSize.width() - appMarginLeft * 2) / metrics.gridColumns[index];
+    int perItemHeight = (containerSize.height() - appMarginTop) / metrics.gridRows[index];
+
+    // 因为每个Item是一个正方形的，所以取宽高中最小的值
+    int perItemSize = qMin(perItemHeight, perItemWidth);
+
+    // 图标大小取区域的4 / 5
+    int appIconSize = perItemSize * 4 / 5;
+
+    return appIconSize;
+}
+
+/**
+ * @brief CalculateUtil::gridContainerSize 估算全屏两种模式下应用网格可用的区域大小
+ * @param metrics 屏幕相关的布局参数
+ * @param mode 全屏自由模式或者全屏分类模式的标识
+ * @return 返回去除搜索框、导航栏、任务栏等区域后的网格区域大小
+ */
+QSize CalculateUtil::gridContainerSize(const LayoutMetrics &metrics, const int mode) const
 {
     // 0.064815 是从FullScreenFrame::updateDockPosition接口中迁移过来用的,为保证间距一致而使用
     int topSpacing = 30;
     int leftSpacing = 0;
     int rightSpacing = 0;
-    int bottomSpacing = (mode == GROUP_BY_CATEGORY) ? getScreenSize().height() * 0.064815 : 20;
+    int bottomSpacing = (mode == GROUP_BY_CATEGORY) ? metrics.screenSize.height() * 0.064815 : 20;
 
     // 计算任务栏位置变化时全屏窗口上各控件的大小
-    switch (m_dockInter->position()) {
+    const QRect dockRect = DisplayTopology::instance()->dockRect();
+    switch (DisplayTopology::instance()->dockPosition()) {
     case DLauncher::DOCK_POS_TOP:
-        topSpacing += QRect(m_dockInter->frontendRect()).height();
+        topSpacing += dockRect.height();
         break;
     case DLauncher::DOCK_POS_BOTTOM:
-        bottomSpacing += QRect(m_dockInter->frontendRect()).height();
+        bottomSpacing += dockRect.height();
         break;
     case DLauncher::DOCK_POS_LEFT:
-        leftSpacing = QRect(m_dockInter->frontendRect()).width();
+        leftSpacing = dockRect.width();
         break;
     case DLauncher::DOCK_POS_RIGHT:
-        rightSpacing = QRect(m_dockInter->frontendRect()).width();
+        rightSpacing = dockRect.width();
         break;
     default:
         break;
@@ -71,57 +119,47 @@ int CalculateUtil::calculateIconSize(int mode)
     QSize containerSize;
 
     if (mode == ALL_APPS) {
-        int padding = getScreenSize().width() * DLauncher::SIDES_SPACE_SCALE;
+        int padding = metrics.screenSize.width() * DLauncher::SIDES_SPACE_SCALE;
         otherAreaSize = QSize(padding + leftSpacing + rightSpacing, DLauncher::APPS_AREA_TOP_MARGIN + bottomSpacing + topSpacing + getSearchWidgetSizeHint().height());
-        containerSize = getScreenSize() - otherAreaSize;
+        containerSize = metrics.screenSize - otherAreaSize;
     } else {
         otherAreaSize = QSize(0, DLauncher::APPS_AREA_TOP_MARGIN + bottomSpacing + topSpacing + getSearchWidgetSizeHint().height() + getNavigationWidgetSizeHint().height() + 12);
-        containerSize = getScreenSize() -  otherAreaSize;
+        containerSize = metrics.screenSize -  otherAreaSize;
     }
 
-    double scaleX = getScreenScaleX();
-    double scaleY = getScreenScaleY();
+    double scaleX = metrics.screenScaleX;
+    double scaleY = metrics.screenScaleY;
     double scale = (qAbs(1 - scaleX) < qAbs(1 - scaleY)) ? scaleX : scaleY;
 
-    calculateTextSize();
-
-    int containerW;
-    int containerH;
-
-    int appColumnCount = 0;
-    int appRowCount = 0;
-
-    // 全屏App模式或者正在搜索列表以4行7列模式排布，全屏分类模式以4行3列模式排布
-    if (mode == ALL_APPS) {
-        appColumnCount = 7;
-        appRowCount = 4;
-
-        containerW = containerSize.width();
-        containerH = containerSize.height() - 20 * scale - DLauncher::DRAG_THRESHOLD;
-    } else {
-        appColumnCount = 4;
-        appRowCount = 3;
-
-        containerW = getAppBoxSize().width();
-        //BlurBoxWidget上边距24,　分组标题高度70 ,　MultiPagesView页面切换按钮高度20 * scale;
-        containerH = containerSize.height() - 24 - 60 - 20 * scale - DLauncher::DRAG_THRESHOLD;
-    }
+    if (mode == ALL_APPS)
+        return QSize(containerSize.width(), int(containerSize.height() - 20 * scale - DLauncher::DRAG_THRESHOLD));
 
-    // 默认边距保留最小５像素
-    int appMarginLeft = 5;
-    int appMarginTop = 5;
+    //BlurBoxWidget上边距24,　分组标题高度70 ,　MultiPagesView页面切换按钮高度20 * scale;
+    return QSize(metrics.appBoxSize.width(), int(containerSize.height() - 24 - 60 - 20 * scale - DLauncher::DRAG_THRESHOLD));
+}
 
-    // 去除默认边距后，计算每个Item区域的宽高
-    int perItemWidth  = (containerW - appMarginLeft * 2) / appColumnCount;
-    int perItemHeight = (containerH - appMarginTop) / appRowCount;
+/**
+ * @brief CalculateUtil::chooseGrid 根据网格区域大小和网格密度选取行列数
+ * 区域大小为逻辑像素, 已经去除了设备像素比的影响, 每个单元格保持接近的逻辑尺寸,
+ * 行列数不少于固定布局, 小屏幕上与原有的7x4和4x3布局一致
+ * @param containerSize 网格区域大小
+ * @param mode 全屏自由模式或者全屏分类模式的标识
+ * @return 返回列数(width)和行数(height)
+ */
+QSize CalculateUtil::chooseGrid(const QSize &containerSize, const int mode) const
+{
+    const bool category = (mode == GROUP_BY_CATEGORY);
+    const QSize fixedGrid = category ? QSize(4, 3) : QSize(7, 4);
+    if (m_gridDensity == FixedGrid)
+        return fixedGrid;
 
-    // 因为每个Item是一个正方形的，所以取宽高中最小的值
-    int perItemSize = qMin(perItemHeight, perItemWidth);
+    const QSize maxGrid = category ? QSize(6, 5) : QSize(12, 7);
+    const int cellSize = (m_gridDensity == CompactGrid) ? 190 : 240;
 
-    // 图标大小取区域的4 / 5
-    int appIconSize = perItemSize * 4 / 5;
+    const int columns = qBound(fixedGrid.width(), containerSize.width() / cellSize, maxGrid.width());
+    const int rows = qBound(fixedGrid.height(), containerSize.height() / cellSize, maxGrid.height());
 
-    return appIconSize;
+    return QSize(columns, rows);
 }
 
 /**
@@ -145,43 +183,38 @@ QSize CalculateUtil::appIconSize() const
     if (!isFullScreen)
         return QSize(DLauncher::APP_ITEM_ICON_SIZE, DLauncher::APP_ITEM_ICON_SIZE);
 
-    QSize s(m_appItemSize, m_appItemSize);
-    double ratio = m_launcherGsettings ? m_launcherGsettings->get("apps-icon-ratio").toDouble() : 0.6;
-    return s * ratio;
+    QSize s(m_metrics.appItemSize, m_metrics.appItemSize);
+    return s * m_metrics.iconRatio;
 }
 
-/**
- * @brief CalculateUtil::getScreenScaleX
- * 获取屏幕宽度为1920的倍数
- * @return 获取屏幕宽度为1920的倍数
- */
-double CalculateUtil::getScreenScaleX()
+double CalculateUtil::iconRatio() const
 {
-    int width  = currentScreen()->geometry().width();
-    return double(width) / 1920;
+    QReadLocker locker(&m_metricsLock);
+    return m_metrics.iconRatio;
 }
 
-/**
- * @brief CalculateUtil::getScreenScaleY
- * 取屏幕高度为1080的倍数
- * @return 取屏幕高度为1080的倍数
- */
-double CalculateUtil::getScreenScaleY()
+LayoutMetrics CalculateUtil::metrics() const
 {
-    int width = currentScreen()->geometry().height();
-    return double(width) / 1080;
+    QReadLocker locker(&m_metricsLock);
+    return m_metrics;
 }
 
-QSize CalculateUtil::getScreenSize() const
+void CalculateUtil::setSearchWidgetSizeHint(const QSize &size)
 {
-    return currentScreen()->geometry().size();
+    if (m_searchWidgetHintSize == size)
+        return;
+
+    m_searchWidgetHintSize = size;
+    updateMetrics();
 }
 
-QSize CalculateUtil::getAppBoxSize()
+void CalculateUtil::setNavigationWidgetSizeHint(const QSize &size)
 {
-    int height = int(currentScreen()->geometry().height() * 0.69);
-    int width = int(currentScreen()->geometry().width() * 0.51);
-    return  QSize(width, height);
+    if (m_navigationWidgetHintSize == size)
+        return;
+
+    m_navigationWidgetHintSize = size;
+    updateMetrics();
 }
 
 bool CalculateUtil::increaseIconSize()
@@ -189,16 +222,38 @@ bool CalculateUtil::increaseIconSize()
     if (!m_launcherGsettings)
         return false;
 
-    const double value = m_launcherGsettings->get("apps-icon-ratio").toDouble();
+    const double value = m_metrics.iconRatio;
     const double ratio = std::min(0.6, value + 0.1);
 
     if (qFuzzyCompare(value, ratio))
         return false;
 
     m_launcherGsettings->set("apps-icon-ratio", ratio);
+
+    // 立即更新快照, 不等待配置变化的通知
+    LayoutMetrics metrics = m_metrics;
+    metrics.iconRatio = ratio;
+    setMetrics(metrics);
     return true;
 }
 
+/**
+ * @brief CalculateUtil::increaseItemSize 增大应用项大小, 与其他布局参数一样通过 setMetrics 加锁更新
+ */
+void CalculateUtil::increaseItemSize()
+{
+    LayoutMetrics metrics = m_metrics;
+    metrics.appItemSize += 16;
+    setMetrics(metrics);
+}
+
+void CalculateUtil::decreaseItemSize()
+{
+    LayoutMetrics metrics = m_metrics;
+    metrics.appItemSize -= 16;
+    setMetrics(metrics);
+}
+
 /**
  * @brief CalculateUtil::calendarSelectIcon
  * 根据系统时间设置日历app的月、周、日样式
@@ -250,13 +305,18 @@ bool CalculateUtil::decreaseIconSize()
     if (!m_launcherGsettings)
         return false;
 
-    const double value = m_launcherGsettings->get("apps-icon-ratio").toDouble();
+    const double value = m_metrics.iconRatio;
     const double ratio = std::max(0.2, value - 0.1);
 
     if (qFuzzyCompare(value, ratio))
         return false;
 
     m_launcherGsettings->set("apps-icon-ratio", ratio);
+
+    // 立即更新快照, 不等待配置变化的通知
+    LayoutMetrics metrics = m_metrics;
+    metrics.iconRatio = ratio;
+    setMetrics(metrics);
     return true;
 }
 
@@ -267,16 +327,8 @@ bool CalculateUtil::decreaseIconSize()
  */
 int CalculateUtil::displayMode() const
 {
-    if (!m_launcherGsettings)
-        return ALL_APPS;
-
-    const QString displayMode = m_launcherGsettings->get(DisplayModeKey).toString();
-
-    if (displayMode == DisplayModeCategory) {
-        return GROUP_BY_CATEGORY;
-    }
-
-    return ALL_APPS;
+    QReadLocker locker(&m_metricsLock);
+    return m_metrics.displayMode;
 }
 
 /**
@@ -287,55 +339,57 @@ int CalculateUtil::displayMode() const
  */
 void CalculateUtil::calculateAppLayout(const QSize &containerSize, const int currentmode)
 {
-    double scaleX = getScreenScaleX();
-    double scaleY = getScreenScaleY();
-    double scale = (qAbs(1 - scaleX) < qAbs(1 - scaleY)) ? scaleX : scaleY;
+    LayoutMetrics metrics = m_metrics;
 
-    calculateTextSize();
+    double scaleX = metrics.screenScaleX;
+    double scaleY = metrics.screenScaleY;
+    double scale = (qAbs(1 - scaleX) < qAbs(1 - scaleY)) ? scaleX : scaleY;
 
     int rows = 1;
     int containerW = containerSize.width();
     int containerH = containerSize.height();
 
-    // 全屏App模式或者正在搜索列表以4行7列模式排布，全屏分类模式以4行3列模式排布
-    if (!m_launcherGsettings || ((m_launcherGsettings->get(DisplayModeKey).toString() == DisplayModeFree) || currentmode == SEARCH)) {
-        m_appColumnCount = 7;
-        rows = 4;
+    // 全屏App模式或者正在搜索列表与全屏分类模式分别按选取的网格行列数排布
+    if (metrics.displayMode == ALL_APPS || currentmode == SEARCH) {
+        metrics.appColumnCount = metrics.gridColumns[ALL_APPS];
+        rows = metrics.gridRows[ALL_APPS];
 
         containerW = containerSize.width();
         containerH = containerSize.height() - 20 * scale - DLauncher::DRAG_THRESHOLD;
     } else {
-        m_appColumnCount = 4;
-        rows = 3;
+        metrics.appColumnCount = metrics.gridColumns[GROUP_BY_CATEGORY];
+        rows = metrics.gridRows[GROUP_BY_CATEGORY];
 
-        containerW = getAppBoxSize().width();
+        containerW = metrics.appBoxSize.width();
         //BlurBoxWidget上边距24,　分组标题高度70 ,　MultiPagesView页面切换按钮高度20 * scale;
         containerH = containerSize.height() - 24 - 60 - 20 * scale - DLauncher::DRAG_THRESHOLD;
     }
 
     // 默认边距保留最小５像素
-    m_appMarginLeft = 5;
-    m_appMarginTop = 5;
+    metrics.appMarginLeft = 5;
+    metrics.appMarginTop = 5;
 
     // 去年默认边距后，计算每个Item区域的宽高
-    int perItemWidth  = (containerW - m_appMarginLeft * 2) / m_appColumnCount;
-    int perItemHeight = (containerH - m_appMarginTop) / rows;
+    int perItemWidth  = (containerW - metrics.appMarginLeft * 2) / metrics.appColumnCount;
+    int perItemHeight = (containerH - metrics.appMarginTop) / rows;
 
     // 因为每个Item是一个正方形的，所以取宽高中最小的值
     int perItemSize = qMin(perItemHeight,perItemWidth);
 
     // 图标大小取区域的4 / 5
-    m_appItemSize = perItemSize * 4 / 5;
+    metrics.appItemSize = perItemSize * 4 / 5;
 
     // 其他区域为间隔区域
-    m_appItemSpacing = (perItemSize - m_appItemSize) / 2;
+    metrics.appItemSpacing = (perItemSize - metrics.appItemSize) / 2;
 
     // 重新计算左右上边距
-    m_appMarginLeft = (containerW - m_appItemSize * m_appColumnCount - m_appItemSpacing * m_appColumnCount * 2) / 2 - 1;
-    m_appMarginTop =  (containerH - m_appItemSize * rows - m_appItemSpacing * rows * 2) / 2;
+    metrics.appMarginLeft = (containerW - metrics.appItemSize * metrics.appColumnCount - metrics.appItemSpacing * metrics.appColumnCount * 2) / 2 - 1;
+    metrics.appMarginTop =  (containerH - metrics.appItemSize * rows - metrics.appItemSpacing * rows * 2) / 2;
 
     // 计算字体大小
-    m_appItemFontSize = m_appItemSize <= 80 ? 8 : qApp->font().pointSize() + 3;
+    metrics.appItemFontSize = metrics.appItemSize <= 80 ? 8 : qApp->font().pointSize() + 3;
+
+    setMetrics(metrics);
 
     emit layoutChanged();
 }
@@ -347,38 +401,108 @@ void CalculateUtil::calculateAppLayout(const QSize &containerSize, const int cur
  */
 CalculateUtil::CalculateUtil(QObject *parent)
     : QObject(parent)
-    , m_dockInter(new DBusDock(this))
     , m_launcherGsettings(SettingsPtr("com.deepin.dde.launcher", "/com/deepin/dde/launcher/", this))
 {
     m_launcherInter = new DBusLauncher(this);
     isFullScreen = m_launcherInter->fullscreen();
+
+    const QString density = getDConfigValue("gridDensity", "standard").toString();
+    m_gridDensity = (density == "fixed") ? FixedGrid : (density == "compact") ? CompactGrid : StandardGrid;
+
+    m_metrics.iconRatio = m_launcherGsettings ? m_launcherGsettings->get("apps-icon-ratio").toDouble() : 0.6;
+    m_metrics.displayMode = (m_launcherGsettings && m_launcherGsettings->get(DisplayModeKey).toString() == DisplayModeCategory)
+            ? GROUP_BY_CATEGORY : ALL_APPS;
+    updateMetrics();
+
+    // 只有屏幕、任务栏、图标比例及显示模式变化时才重新计算布局参数
+    connect(DisplayTopology::instance(), &DisplayTopology::topologyChanged, this, &CalculateUtil::updateMetrics);
+    connect(DisplayTopology::instance(), &DisplayTopology::dockRectChanged, this, &CalculateUtil::updateMetrics);
+    connect(DisplayTopology::instance(), &DisplayTopology::dockPositionChanged, this, &CalculateUtil::updateMetrics);
+
+    if (m_launcherGsettings)
+        connect(m_launcherGsettings, &QGSettings::changed, this, &CalculateUtil::onGSettingChanged);
 }
 
-void CalculateUtil::calculateTextSize()
+void CalculateUtil::calculateTextSize(LayoutMetrics &metrics) const
 {
-    if (currentScreen()->geometry().width() > 1366) {
-        m_navgationTextSize = 14;
-        m_titleTextSize = 40;
+    if (metrics.screenSize.width() > 1366) {
+        metrics.navgationTextSize = 14;
+        metrics.titleTextSize = 40;
     } else {
-        m_navgationTextSize = 11;
-        m_titleTextSize = 38;
+        metrics.navgationTextSize = 11;
+        metrics.titleTextSize = 38;
     }
 }
 
-QScreen *CalculateUtil::currentScreen() const
+/**
+ * @brief CalculateUtil::updateMetrics 根据当前屏幕及任务栏重新计算与屏幕相关的布局参数
+ */
+void CalculateUtil::updateMetrics()
 {
-    QScreen * s = qApp->primaryScreen();
-    const QRect dockRect = m_dockInter->frontendRect();
-    const auto ratio = qApp->devicePixelRatio();
-
-    for (auto *screen : qApp->screens()) {
-        const QRect &sg = screen->geometry();
-        const QRect &rg = QRect(sg.topLeft(), sg.size() * ratio);
-        if (rg.contains(dockRect.topLeft())) {
-            s = screen;
-            break;
-        }
+    LayoutMetrics metrics = m_metrics;
+
+    const QSize screenSize = currentScreen()->geometry().size();
+    metrics.screenSize = screenSize;
+    metrics.appBoxSize = QSize(int(screenSize.width() * 0.51), int(screenSize.height() * 0.69));
+    metrics.screenScaleX = double(screenSize.width()) / 1920;
+    metrics.screenScaleY = double(screenSize.height()) / 1080;
+    calculateTextSize(metrics);
+
+    for (const int mode : { ALL_APPS, GROUP_BY_CATEGORY }) {
+        const QSize grid = chooseGrid(gridContainerSize(metrics, mode), mode);
+        metrics.gridColumns[mode] = grid.width();
+        metrics.gridRows[mode] = grid.height();
+        metrics.iconSizes[mode] = calculateIconSize(metrics, mode);
     }
 
-    return  s;
+    const bool pageCountChanged = metrics.pageItemCount(ALL_APPS) != m_metrics.pageItemCount(ALL_APPS)
+            || metrics.pageItemCount(GROUP_BY_CATEGORY) != m_metrics.pageItemCount(GROUP_BY_CATEGORY);
+
+    setMetrics(metrics);
+
+    // 每页应用数变化后由界面重新分页, 已有的页面按新的页数增减
+    if (pageCountChanged)
+        emit pageItemCountChanged();
+}
+
+/**
+ * @brief CalculateUtil::setGridDensity 设置网格密度并重新选取行列数
+ * @param density 网格密度
+ */
+void CalculateUtil::setGridDensity(const GridDensity density)
+{
+    if (m_gridDensity == density)
+        return;
+
+    m_gridDensity = density;
+    updateMetrics();
+}
+
+void CalculateUtil::onGSettingChanged(const QString &key)
+{
+    if (!m_launcherGsettings)
+        return;
+
+    LayoutMetrics metrics = m_metrics;
+    if (key == "apps-icon-ratio" || key == "appsIconRatio") {
+        metrics.iconRatio = m_launcherGsettings->get("apps-icon-ratio").toDouble();
+    } else if (key == DisplayModeKey || key == "displayMode") {
+        metrics.displayMode = m_launcherGsettings->get(DisplayModeKey).toString() == DisplayModeCategory
+                ? GROUP_BY_CATEGORY : ALL_APPS;
+    } else {
+        return;
+    }
+
+    setMetrics(metrics);
+}
+
+void CalculateUtil::setMetrics(const LayoutMetrics &metrics)
+{
+    QWriteLocker locker(&m_metricsLock);
+    m_metrics = metrics;
+}
+
+QScreen *CalculateUtil::currentScreen() const
+{
+    return DisplayTopology::instance()->currentScreen();
 }
@@ -13,34 +13,75 @@
 #include <DSysInfo>
 
 #include "dbuslauncher.h"
-#include "dbusdock.h"
 
 #define ALL_APPS            0       // 全屏自由模式
 #define GROUP_BY_CATEGORY   1       // 全屏分类模式
 #define SEARCH              2       // 全屏搜索模式
 
 DCORE_USE_NAMESPACE
+
+/**
+ * @brief The LayoutMetrics struct
+ * 布局参数快照, 屏幕、任务栏、图标比例、显示模式或容器大小变化时整体重新计算后替换,
+ * 各处读取时只访问快照中的值, 不再查询 D-Bus 或 GSettings
+ */
+struct LayoutMetrics
+{
+    QSize screenSize;
+    QSize appBoxSize;                                   // 全屏分类模式下分类控件的大小, 屏幕宽度的0.51, 高度的0.69
+    double screenScaleX = 1.0;                          // 屏幕宽度为1920的倍数
+    double screenScaleY = 1.0;                          // 屏幕高度为1080的倍数
+    int titleTextSize = 40;
+    int navgationTextSize = 14;
+    double iconRatio = 0.6;                             // apps-icon-ratio
+    int displayMode = 0;                                // 全屏自由模式或全屏分类模式
+    int iconSizes[2] = { 0, 0 };                        // calculateIconSize 按模式的计算结果
+    int gridColumns[2] = { 7, 4 };                      // 按模式选取的网格列数, 默认为固定的7列和4列
+    int gridRows[2] = { 4, 3 };                         // 按模式选取的网格行数, 默认为固定的4行和3行
+
+    int appItemFontSize = 12;
+    int appItemSpacing = 10;
+    int appMarginLeft = 0;
+    int appMarginTop = 0;
+    int appItemSize = 130;
+    int appColumnCount = 7;
+
+    inline int pageItemCount(const int mode) const { return gridColumns[mode] * gridRows[mode]; }
+};
+
 class CalculateUtil : public QObject
 {
     Q_OBJECT
 
 signals:
     void layoutChanged() const;
+    void pageItemCountChanged() const;
 
 public:
+    /**
+     * @brief The GridDensity enum
+     * 网格密度, Fixed 为原有的7x4和4x3布局, 其余按屏幕大小选取行列数
+     */
+    enum GridDensity {
+        FixedGrid,
+        StandardGrid,
+        CompactGrid
+    };
+
     static CalculateUtil *instance();
 
-    inline int titleTextSize() const {return m_titleTextSize;}
+    inline int titleTextSize() const {return m_metrics.titleTextSize;}
     // NOTE: navgation text size animation max zoom scale is 1.2
-    inline int navgationTextSize() const {return double(m_navgationTextSize) / 1.2;}
-    inline int appColumnCount() const {return m_appColumnCount;}
-    inline int appItemFontSize() const {return m_appItemFontSize;}
-    inline int appItemSpacing() const {return m_appItemSpacing;}
-    inline int appMarginLeft() const {return m_appMarginLeft;}
-    inline int appMarginTop() const {return m_appMarginTop;}
-    inline int appPageItemCount(AppsListModel::AppCategory category) const {return category > AppsListModel::Category ? m_categoryAppPageItemCount : m_appPageItemCount;}
+    inline int navgationTextSize() const {return double(m_metrics.navgationTextSize) / 1.2;}
+    inline int appColumnCount() const {return m_metrics.appColumnCount;}
+    inline int appItemFontSize() const {return m_metrics.appItemFontSize;}
+    inline int appItemSpacing() const {return m_metrics.appItemSpacing;}
+    inline int appMarginLeft() const {return m_metrics.appMarginLeft;}
+    inline int appMarginTop() const {return m_metrics.appMarginTop;}
+    inline int appPageItemCount(AppsListModel::AppCategory category) const {return m_metrics.pageItemCount(category > AppsListModel::Category ? GROUP_BY_CATEGORY : ALL_APPS);}
     inline int appCategoryCount() const {return m_categoryCount;}
-    inline QSize appItemSize() const { return QSize(m_appItemSize, m_appItemSize); }
+    inline QSize appItemSize() const { return QSize(m_metrics.appItemSize, m_metrics.appItemSize); }
+    LayoutMetrics metrics() const;
     inline bool fullscreen() const {return isFullScreen;}
     inline int currentCategory() const {return m_currentCategory;}
     void setCurrentCategory(int category){m_currentCategory = category;}
@@ -48,26 +89,29 @@ public:
 
     QSize appIconSize() const;
     QSize appIconSize(bool fullscreen, double ratio, int iconSize = 0) const;
+    double iconRatio() const;
     int displayMode() const;
     void setDisplayMode(const int mode);
-    int calculateIconSize(const int mode);
+    int calculateIconSize(const int mode) const;
+    inline GridDensity gridDensity() const { return m_gridDensity; }
+    void setGridDensity(const GridDensity density);
     QSize getSearchWidgetSizeHint() const { return  m_searchWidgetHintSize; }
-    void setSearchWidgetSizeHint(const QSize &size) { m_searchWidgetHintSize = size; }
+    void setSearchWidgetSizeHint(const QSize &size);
     QSize getNavigationWidgetSizeHint() const { return m_navigationWidgetHintSize; }
-    void setNavigationWidgetSizeHint(const QSize &size) { m_navigationWidgetHintSize = size; }
+    void setNavigationWidgetSizeHint(const QSize &size);
 
     bool increaseIconSize();
     bool decreaseIconSize();
-    inline void increaseItemSize() { m_appItemSize += 16; }
-    inline void decreaseItemSize() { m_appItemSize -= 16; }
+    void increaseItemSize();
+    void decreaseItemSize();
     const DSysInfo::DeepinType DeepinType = DSysInfo::deepinType();
     const bool IsServerSystem = (DSysInfo::DeepinServer == DeepinType);
 
     inline int navigationHeight() { return 90; }
-    QSize getAppBoxSize() ;
-    QSize getScreenSize() const;
-    double getScreenScaleX();
-    double getScreenScaleY();
+    inline QSize getAppBoxSize() const { return m_metrics.appBoxSize; }
+    inline QSize getScreenSize() const { return m_metrics.screenSize; }
+    inline double getScreenScaleX() const { return m_metrics.screenScaleX; }
+    inline double getScreenScaleY() const { return m_metrics.screenScaleY; }
 
     QStringList calendarSelectIcon() const;
 
@@ -76,28 +120,28 @@ public slots:
 
 private:
     explicit CalculateUtil(QObject *parent);
-    void calculateTextSize();
+    void calculateTextSize(LayoutMetrics &metrics) const;
+    int calculateIconSize(const LayoutMetrics &metrics, const int mode) const;
+    QSize gridContainerSize(const LayoutMetrics &metrics, const int mode) const;
+    QSize chooseGrid(const QSize &containerSize, const int mode) const;
+    void setMetrics(const LayoutMetrics &metrics);
     QScreen *currentScreen() const;
 
+private slots:
+    void updateMetrics();
+    void onGSettingChanged(const QString &key);
+
 private:
     static QPointer<CalculateUtil> INSTANCE;
 
-    int m_appItemFontSize = 12;
-    int m_appItemSpacing = 10;
-    int m_appMarginLeft = 0;
-    int m_appMarginTop = 0;
-    int m_appItemSize = 130;
-    int m_appColumnCount = 7;
-    int m_navgationTextSize = 14;
-    int m_appPageItemCount = 28;
-    int m_titleTextSize = 40;
-    int m_categoryAppPageItemCount = 12;
+    LayoutMetrics m_metrics;
+    mutable QReadWriteLock m_metricsLock;               // 图标加载线程同样读取布局参数
+    GridDensity m_gridDensity;
     int m_categoryCount = 11;
     int m_currentCategory = 4;
     bool isFullScreen;
 
     DBusLauncher *m_launcherInter;
-    DBusDock *m_dockInter;
 
     QGSettings *m_launcherGsettings;
 
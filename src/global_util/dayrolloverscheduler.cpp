@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dayrolloverscheduler.h"
+
+#include <QDateTime>
+#include <QDBusConnection>
+#include <QDebug>
+#include <QSocketNotifier>
+#include <QTimer>
+
+#include <cerrno>
+#include <cstring>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+QPointer<DayRolloverScheduler> DayRolloverScheduler::INSTANCE = nullptr;
+
+DayRolloverScheduler *DayRolloverScheduler::instance()
+{
+    if (INSTANCE.isNull())
+        INSTANCE = new DayRolloverScheduler(nullptr);
+
+    return INSTANCE;
+}
+
+DayRolloverScheduler::DayRolloverScheduler(QObject *parent)
+    : QObject(parent)
+    , m_date(QDate::currentDate())
+    , m_timerFd(timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC))
+    , m_notifier(nullptr)
+    , m_fallbackTimer(nullptr)
+{
+    if (m_timerFd >= 0) {
+        m_notifier = new QSocketNotifier(m_timerFd, QSocketNotifier::Read, this);
+        connect(m_notifier, &QSocketNotifier::activated, this, &DayRolloverScheduler::onTimerActivated);
+    } else {
+        qWarning() << "timerfd_create failed, fall back to QTimer:" << strerror(errno);
+        m_fallbackTimer = new QTimer(this);
+        m_fallbackTimer->setSingleShot(true);
+        m_fallbackTimer->setTimerType(Qt::VeryCoarseTimer);
+        connect(m_fallbackTimer, &QTimer::timeout, this, &DayRolloverScheduler::onTimerActivated);
+    }
+
+    // 系统唤醒及时区变化时重新计算, 挂起期间单调时钟停止计时, 定时器不能保证按时触发
+    QDBusConnection::systemBus().connect("org.freedesktop.login1", "/org/freedesktop/login1", "org.freedesktop.login1.Manager",
+                                         "PrepareForSleep", this, SLOT(reschedule()));
+    QDBusConnection::systemBus().connect("org.freedesktop.timedate1", "/org/freedesktop/timedate1", "org.freedesktop.DBus.Properties",
+                                         "PropertiesChanged", this, SLOT(reschedule()));
+
+    arm();
+}
+
+DayRolloverScheduler::~DayRolloverScheduler()
+{
+    if (m_timerFd >= 0)
+        close(m_timerFd);
+}
+
+/**
+ * @brief DayRolloverScheduler::reschedule 检查日期是否变化, 变化时发出通知, 并重新设置下一个零点
+ */
+void DayRolloverScheduler::reschedule()
+{
+    const QDate date = QDate::currentDate();
+    if (date != m_date) {
+        m_date = date;
+        emit dayChanged(date);
+    }
+
+    arm();
+}
+
+/**
+ * @brief DayRolloverScheduler::arm 设置在下一个本地零点触发的定时器
+ * timerfd 使用绝对的系统时间, 挂起期间同样计时, 系统时间被修改时读取返回 ECANCELED, 随后重新设置
+ */
+void DayRolloverScheduler::arm()
+{
+    const QDateTime midnight(m_date.addDays(1), QTime(0, 0));
+    const qint64 msecs = midnight.toMSecsSinceEpoch();
+
+    if (m_timerFd < 0) {
+        // 多等待一秒, 避免粗粒度定时器在零点之前触发
+        const qint64 remaining = qMax<qint64>(0, msecs - QDateTime::currentMSecsSinceEpoch());
+        m_fallbackTimer->start(int(remaining) + 1000);
+        return;
+    }
+
+    itimerspec spec {};
+    spec.it_value.tv_sec = msecs / 1000;
+    spec.it_value.tv_nsec = (msecs % 1000) * 1000000;
+
+    if (timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &spec, nullptr) < 0)
+        qWarning() << "timerfd_settime failed:" << strerror(errno);
+}
+
+void DayRolloverScheduler::onTimerActivated()
+{
+    if (m_timerFd >= 0) {
+        // 到期或系统时间被修改(ECANCELED)时均可读, 读取后清除可读状态
+        quint64 expirations = 0;
+        if (read(m_timerFd, &expirations, sizeof(expirations)) < 0 && errno != ECANCELED && errno != EAGAIN)
+            qWarning() << "read timerfd failed:" << strerror(errno);
+    }
+
+    reschedule();
+}
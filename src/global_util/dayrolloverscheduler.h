@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DAYROLLOVERSCHEDULER_H
+#define DAYROLLOVERSCHEDULER_H
+
+#include <QDate>
+#include <QObject>
+#include <QPointer>
+
+class QSocketNotifier;
+class QTimer;
+
+/**
+ * @brief The DayRolloverScheduler class
+ * 日期切换通知, 只在下一个本地零点唤醒一次进程, 代替每秒轮询日期的定时器,
+ * 系统唤醒、时区变化以及系统时间被修改后重新计算下一个零点
+ */
+class DayRolloverScheduler : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void dayChanged(const QDate &date);
+
+public:
+    static DayRolloverScheduler *instance();
+    ~DayRolloverScheduler() override;
+
+    inline QDate currentDate() const { return m_date; }
+
+public slots:
+    void reschedule();
+
+private:
+    explicit DayRolloverScheduler(QObject *parent = nullptr);
+
+    void arm();
+
+private slots:
+    void onTimerActivated();
+
+private:
+    static QPointer<DayRolloverScheduler> INSTANCE;
+
+    QDate m_date;
+    int m_timerFd;                                      // CLOCK_REALTIME 的 timerfd, 创建失败时使用 m_fallbackTimer
+    QSocketNotifier *m_notifier;
+    QTimer *m_fallbackTimer;
+};
+
+#endif // DAYROLLOVERSCHEDULER_H
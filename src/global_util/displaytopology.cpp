@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "displaytopology.h"
+
+#include <QGuiApplication>
+#include <QDBusPendingCallWatcher>
+
+QPointer<DisplayTopology> DisplayTopology::INSTANCE = nullptr;
+
+DisplayTopology *DisplayTopology::instance()
+{
+    if (INSTANCE.isNull())
+        INSTANCE = new DisplayTopology(nullptr);
+
+    return INSTANCE;
+}
+
+/**
+ * @brief DisplayTopology::DisplayTopology 启动时同步读取一次任务栏区域、位置和显示模式, 之后均为异步更新
+ * @param parent 父对象
+ */
+DisplayTopology::DisplayTopology(QObject *parent)
+    : QObject(parent)
+    , m_dockInter(new DBusDock(this))
+    , m_displayInter(new com::deepin::daemon::Display("com.deepin.daemon.Display", "/com/deepin/daemon/Display", QDBusConnection::sessionBus(), this))
+    , m_primaryScreen(nullptr)
+    , m_currentScreen(nullptr)
+    , m_dockRect(m_dockInter->frontendRect())
+    , m_dockPosition(m_dockInter->position())
+    , m_displayMode(m_displayInter->GetRealDisplayMode())
+{
+    updateScreens();
+
+    connect(qApp, &QGuiApplication::screenAdded, this, &DisplayTopology::updateScreens);
+    connect(qApp, &QGuiApplication::screenRemoved, this, &DisplayTopology::updateScreens);
+    connect(qApp, &QGuiApplication::primaryScreenChanged, this, &DisplayTopology::updateScreens);
+
+    connect(m_dockInter, &DBusDock::FrontendRectChanged, this, &DisplayTopology::requestDockRect);
+    connect(m_dockInter, &DBusDock::PositionChanged, this, &DisplayTopology::requestDockPosition);
+    connect(m_displayInter, &com::deepin::daemon::Display::DisplayModeChanged, this, &DisplayTopology::requestDisplayMode);
+    connect(m_displayInter, &com::deepin::daemon::Display::PrimaryChanged, this, &DisplayTopology::requestDisplayMode);
+}
+
+/**
+ * @brief DisplayTopology::screenAt 获取包含指定位置的屏幕
+ * @param pos 全局坐标
+ * @return 包含该位置的屏幕, 不在任何屏幕内时返回主屏
+ */
+QScreen *DisplayTopology::screenAt(const QPoint &pos) const
+{
+    for (QScreen *screen : m_screens) {
+        if (screen->geometry().contains(pos))
+            return screen;
+    }
+
+    return m_primaryScreen;
+}
+
+void DisplayTopology::updateScreens()
+{
+    for (QScreen *screen : m_screens)
+        disconnect(screen, nullptr, this, nullptr);
+
+    m_screens = qApp->screens();
+    m_primaryScreen = qApp->primaryScreen();
+
+    for (QScreen *screen : m_screens) {
+        connect(screen, &QScreen::geometryChanged, this, &DisplayTopology::updateScreens);
+        connect(screen, &QScreen::logicalDotsPerInchChanged, this, &DisplayTopology::updateScreens);
+    }
+
+    updateCurrentScreen();
+    emit topologyChanged();
+}
+
+/**
+ * @brief DisplayTopology::updateCurrentScreen 根据任务栏区域确定启动器所在屏幕
+ */
+void DisplayTopology::updateCurrentScreen()
+{
+    m_currentScreen = m_primaryScreen;
+
+    // 任务栏区域为物理像素坐标
+    const qreal ratio = qApp->devicePixelRatio();
+    for (QScreen *screen : m_screens) {
+        const QRect &sg = screen->geometry();
+        const QRect &rg = QRect(sg.topLeft(), sg.size() * ratio);
+        if (rg.contains(m_dockRect.topLeft())) {
+            m_currentScreen = screen;
+            break;
+        }
+    }
+}
+
+void DisplayTopology::requestDockRect()
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(m_dockInter->service(), m_dockInter->path(),
+                                                      "org.freedesktop.DBus.Properties", "Get");
+    msg << m_dockInter->interface() << "FrontendWindowRect";
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_dockInter->connection().asyncCall(msg), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
+
+        QDBusPendingReply<QDBusVariant> reply = *call;
+        if (reply.isError())
+            return;
+
+        const QRect dockRect = qdbus_cast<DockRect>(reply.value().variant().value<QDBusArgument>());
+        if (dockRect == m_dockRect)
+            return;
+
+        m_dockRect = dockRect;
+        updateCurrentScreen();
+        emit dockRectChanged();
+    });
+}
+
+void DisplayTopology::requestDockPosition()
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(m_dockInter->service(), m_dockInter->path(),
+                                                      "org.freedesktop.DBus.Properties", "Get");
+    msg << m_dockInter->interface() << "Position";
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_dockInter->connection().asyncCall(msg), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
+
+        QDBusPendingReply<QDBusVariant> reply = *call;
+        if (reply.isError())
+            return;
+
+        const int dockPosition = reply.value().variant().toInt();
+        if (dockPosition == m_dockPosition)
+            return;
+
+        m_dockPosition = dockPosition;
+        emit dockPositionChanged();
+    });
+}
+
+void DisplayTopology::requestDisplayMode()
+{
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_displayInter->GetRealDisplayMode(), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
+
+        QDBusPendingReply<uchar> reply = *call;
+        if (reply.isError() || reply.value() == m_displayMode)
+            return;
+
+        m_displayMode = reply.value();
+        emit topologyChanged();
+    });
+}
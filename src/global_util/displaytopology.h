@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DISPLAYTOPOLOGY_H
+#define DISPLAYTOPOLOGY_H
+
+#include "dbusdock.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QRect>
+#include <QScreen>
+
+#include <com_deepin_daemon_display.h>
+
+/**
+ * @brief The DisplayTopology class
+ * 屏幕拓扑信息缓存, 记录屏幕列表、主屏、任务栏所在屏幕、区域及位置以及多屏显示模式,
+ * 屏幕及任务栏、显示服务的属性变化时异步更新, 查询时直接返回内存中的结果
+ */
+class DisplayTopology : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void topologyChanged();
+    void dockRectChanged();
+    void dockPositionChanged();
+
+public:
+    static DisplayTopology *instance();
+
+    inline const QList<QScreen *> &screens() const { return m_screens; }
+    inline QScreen *primaryScreen() const { return m_primaryScreen; }
+    inline QScreen *currentScreen() const { return m_currentScreen; }
+    inline QRect dockRect() const { return m_dockRect; }
+    inline int dockPosition() const { return m_dockPosition; }
+    inline int displayMode() const { return m_displayMode; }
+
+    QScreen *screenAt(const QPoint &pos) const;
+
+private:
+    explicit DisplayTopology(QObject *parent = nullptr);
+
+    void updateScreens();
+    void updateCurrentScreen();
+    void requestDockRect();
+    void requestDockPosition();
+    void requestDisplayMode();
+
+private:
+    static QPointer<DisplayTopology> INSTANCE;
+
+    DBusDock *m_dockInter;
+    com::deepin::daemon::Display *m_displayInter;
+
+    QList<QScreen *> m_screens;
+    QScreen *m_primaryScreen;
+    QScreen *m_currentScreen;                           // 任务栏所在屏幕, 即启动器显示的屏幕
+    QRect m_dockRect;
+    int m_dockPosition;
+    int m_displayMode;
+};
+
+#endif // DISPLAYTOPOLOGY_H
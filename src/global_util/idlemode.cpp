@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "idlemode.h"
+
+QPointer<IdleMode> IdleMode::INSTANCE = nullptr;
+
+IdleMode *IdleMode::instance()
+{
+    if (INSTANCE.isNull())
+        INSTANCE = new IdleMode(nullptr);
+
+    return INSTANCE;
+}
+
+IdleMode::IdleMode(QObject *parent)
+    : QObject(parent)
+    , m_idle(false)
+{
+}
+
+/**
+ * @brief IdleMode::enter 启动器隐藏后进入空闲状态
+ */
+void IdleMode::enter()
+{
+    if (m_idle)
+        return;
+
+    m_idle = true;
+    emit idleChanged(true);
+}
+
+/**
+ * @brief IdleMode::leave 启动器即将显示时退出空闲状态, 各模块在信号处理中同步完成隐藏期间记录的任务
+ */
+void IdleMode::leave()
+{
+    if (!m_idle)
+        return;
+
+    m_idle = false;
+    emit idleChanged(false);
+}
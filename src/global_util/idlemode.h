@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef IDLEMODE_H
+#define IDLEMODE_H
+
+#include <QObject>
+#include <QPointer>
+
+/**
+ * @brief The IdleMode class
+ * 启动器隐藏时的空闲状态, 空闲期间各模块只记录非紧急的变化, 不启动定时器和刷新任务,
+ * 退出空闲状态(即将显示)时由各模块一次性处理记录的任务
+ */
+class IdleMode : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void idleChanged(bool idle);
+
+public:
+    static IdleMode *instance();
+
+    inline bool isIdle() const { return m_idle; }
+
+    void enter();
+    void leave();
+
+private:
+    explicit IdleMode(QObject *parent = nullptr);
+
+private:
+    static QPointer<IdleMode> INSTANCE;
+
+    bool m_idle;
+};
+
+#endif // IDLEMODE_H
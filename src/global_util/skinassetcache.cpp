@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "skinassetcache.h"
+#include "util.h"
+
+#include <DHiDPIHelper>
+#include <DGuiApplicationHelper>
+
+#include <QApplication>
+#include <QIcon>
+
+DWIDGET_USE_NAMESPACE
+DGUI_USE_NAMESPACE
+
+QReadWriteLock SkinAssetCache::m_assetLock;
+QHash<SkinAssetCache::AssetKey, QPixmap> SkinAssetCache::m_assetCache = QHash<SkinAssetCache::AssetKey, QPixmap>();
+
+bool SkinAssetCache::AssetKey::operator==(const AssetKey &other) const
+{
+    return loader == other.loader && theme == other.theme && size == other.size
+            && qFuzzyCompare(ratio, other.ratio) && path == other.path;
+}
+
+uint qHash(const SkinAssetCache::AssetKey &key, uint seed)
+{
+    return qHash(key.path, seed) ^ qHash(key.size.width() << 16 | key.size.height(), seed)
+            ^ qHash(qRound(key.ratio * 100), seed) ^ qHash(key.theme << 4 | key.loader, seed);
+}
+
+/**
+ * @brief SkinAssetCache::svg 获取按逻辑尺寸渲染的 svg 图片, 等同于 renderSVG
+ * @param path 资源路径
+ * @param size 逻辑尺寸
+ * @return 共享的图片对象
+ */
+QPixmap SkinAssetCache::svg(const QString &path, const QSize &size)
+{
+    return fetch(RenderSvg, path, size);
+}
+
+/**
+ * @brief SkinAssetCache::squareSvg 获取按物理像素渲染的正方形 svg 图片, 等同于 loadSvg
+ * @param path 资源路径
+ * @param pixelSize 物理像素尺寸
+ * @return 共享的图片对象
+ */
+QPixmap SkinAssetCache::squareSvg(const QString &path, const int pixelSize)
+{
+    return fetch(SquareSvg, path, QSize(pixelSize, pixelSize));
+}
+
+/**
+ * @brief SkinAssetCache::nxPixmap 获取适配当前缩放的图片, 等同于 DHiDPIHelper::loadNxPixmap
+ * @param path 资源路径
+ * @return 共享的图片对象
+ */
+QPixmap SkinAssetCache::nxPixmap(const QString &path)
+{
+    return fetch(NxPixmap, path, QSize());
+}
+
+/**
+ * @brief SkinAssetCache::iconPixmap 获取 QIcon 按逻辑尺寸渲染的图片
+ * @param path 资源路径
+ * @param size 逻辑尺寸
+ * @return 共享的图片对象
+ */
+QPixmap SkinAssetCache::iconPixmap(const QString &path, const QSize &size)
+{
+    return fetch(IconPixmap, path, size);
+}
+
+/**
+ * @brief SkinAssetCache::fallbackAppIcon 应用图标缺失时使用的默认齿轮图标
+ * @param size 逻辑尺寸
+ * @return 共享的图片对象
+ */
+QPixmap SkinAssetCache::fallbackAppIcon(const int size)
+{
+    return iconPixmap(":/widgets/images/application-x-desktop.svg", QSize(size, size));
+}
+
+void SkinAssetCache::clear()
+{
+    QWriteLocker locker(&m_assetLock);
+    m_assetCache.clear();
+}
+
+int SkinAssetCache::count()
+{
+    QReadLocker locker(&m_assetLock);
+    return m_assetCache.size();
+}
+
+QPixmap SkinAssetCache::fetch(const Loader loader, const QString &path, const QSize &size)
+{
+    AssetKey key { path, size, qApp->devicePixelRatio(), DGuiApplicationHelper::instance()->themeType(), loader };
+
+    {
+        QReadLocker locker(&m_assetLock);
+        auto it = m_assetCache.constFind(key);
+        if (it != m_assetCache.constEnd())
+            return it.value();
+    }
+
+    // 渲染过程不持有锁, 并发未命中时以先写入的结果为准
+    const QPixmap pixmap = load(key);
+    if (pixmap.isNull())
+        return pixmap;
+
+    QWriteLocker locker(&m_assetLock);
+    auto it = m_assetCache.constFind(key);
+    if (it != m_assetCache.constEnd())
+        return it.value();
+
+    m_assetCache.insert(key, pixmap);
+    return pixmap;
+}
+
+QPixmap SkinAssetCache::load(const AssetKey &key)
+{
+    switch (key.loader) {
+    case RenderSvg:
+        return renderSVG(key.path, key.size);
+    case SquareSvg:
+        return loadSvg(key.path, key.size.width());
+    case NxPixmap:
+        return DHiDPIHelper::loadNxPixmap(key.path);
+    case IconPixmap: {
+        QPixmap pixmap = QIcon(key.path).pixmap(key.size * key.ratio);
+        pixmap.setDevicePixelRatio(key.ratio);
+        return pixmap;
+    }
+    }
+
+    return QPixmap();
+}
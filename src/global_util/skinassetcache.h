@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SKINASSETCACHE_H
+#define SKINASSETCACHE_H
+
+#include <QHash>
+#include <QPixmap>
+#include <QReadWriteLock>
+#include <QSize>
+#include <QString>
+
+/**
+ * @brief The SkinAssetCache class
+ * 进程内共享的皮肤资源缓存, 按资源路径、尺寸、设备像素比以及主题类型缓存渲染后的图片,
+ * 绘制流程中直接取用共享的 QPixmap, 不再重复解析 svg 文件
+ */
+class SkinAssetCache
+{
+public:
+    static QPixmap svg(const QString &path, const QSize &size);
+    static QPixmap squareSvg(const QString &path, const int pixelSize);
+    static QPixmap nxPixmap(const QString &path);
+    static QPixmap iconPixmap(const QString &path, const QSize &size);
+    static QPixmap fallbackAppIcon(const int size);
+
+    static void clear();
+    static int count();
+
+private:
+    enum Loader {
+        RenderSvg,                  // renderSVG, 逻辑尺寸
+        SquareSvg,                  // loadSvg, 物理像素尺寸
+        NxPixmap,                   // DHiDPIHelper::loadNxPixmap
+        IconPixmap                  // QIcon::pixmap
+    };
+
+    struct AssetKey {
+        QString path;
+        QSize size;
+        qreal ratio;
+        int theme;
+        Loader loader;
+
+        bool operator==(const AssetKey &other) const;
+    };
+
+    friend uint qHash(const AssetKey &key, uint seed);
+
+    static QPixmap fetch(const Loader loader, const QString &path, const QSize &size);
+    static QPixmap load(const AssetKey &key);
+
+private:
+    static QReadWriteLock m_assetLock;
+    static QHash<AssetKey, QPixmap> m_assetCache;
+};
+
+#endif // SKINASSETCACHE_H
@@ -5,6 +5,7 @@
 #include "util.h"
 #include "appsmanager.h"
 #include "iconcachemanager.h"
+#include "skinassetcache.h"
 
 #include <DHiDPIHelper>
 #include <DGuiApplicationHelper>
@@ -21,6 +22,8 @@
 #include <QScopedPointer>
 #include <QIconEngine>
 #include <QSharedPointer>
+#include <QCryptographicHash>
+#include <QReadWriteLock>
 
 #include <private/qguiapplication_p.h>
 #include <private/qiconloader_p.h>
@@ -393,8 +396,9 @@ bool getThemeIcon(QPixmap &pixmap, const ItemInfo &itemInfo, const int size, boo
             icon = QIcon::fromTheme(iconName);
 
         if (icon.isNull()) {
-            icon = QIcon(":/widgets/images/application-x-desktop.svg");
+            pixmap = SkinAssetCache::fallbackAppIcon(iconSize);
             findIcon = false;
+            break;
         }
 
         pixmap = icon.pixmap(QSize(iconSize, iconSize) * ratio);
@@ -405,12 +409,88 @@ bool getThemeIcon(QPixmap &pixmap, const ItemInfo &itemInfo, const int size, boo
     pixmap = pixmap.scaled(QSize(iconSize, iconSize) * ratio, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     pixmap.setDevicePixelRatio(ratio);
 
-    if (!IconCacheManager::existInCache(tmpKey) && findIcon)
+    // insertCache 内部只在缓存缺失时写入，无需预先查询
+    if (findIcon)
         IconCacheManager::insertCache(tmpKey, pixmap);
 
     return findIcon;
 }
 
+/**
+ * @brief isVectorIconSource 判断应用图标是否来源于矢量图或图标主题
+ * 图标主题中小尺寸图标可能存在单独优化过的资源, 这类图标在小尺寸下需要重新渲染
+ * @param itemInfo 应用程序信息
+ * @return 矢量图或主题图标返回true, 位图文件或内嵌数据返回false
+ */
+bool isVectorIconSource(const ItemInfo &itemInfo)
+{
+    const QString &iconKey = itemInfo.m_iconKey;
+    if (iconKey.startsWith("data:image/"))
+        return iconKey.startsWith("data:image/svg");
+
+    if (QFile::exists(iconKey))
+        return iconKey.endsWith(".svg") || iconKey.endsWith(".svgz");
+
+    return true;
+}
+
+/**
+ * @brief boxDownsample 对图片做2x2的box滤波, 生成宽高各缩小一半的下一级mip图
+ * @param image 源图片
+ * @return 缩小后的图片
+ */
+QImage boxDownsample(const QImage &image)
+{
+    const QImage source = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const int width = qMax(1, source.width() / 2);
+    const int height = qMax(1, source.height() / 2);
+
+    QImage target(width, height, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < height; ++y) {
+        const QRgb *line0 = reinterpret_cast<const QRgb *>(source.constScanLine(qMin(2 * y, source.height() - 1)));
+        const QRgb *line1 = reinterpret_cast<const QRgb *>(source.constScanLine(qMin(2 * y + 1, source.height() - 1)));
+        QRgb *dst = reinterpret_cast<QRgb *>(target.scanLine(y));
+
+        for (int x = 0; x < width; ++x) {
+            const int x0 = qMin(2 * x, source.width() - 1);
+            const int x1 = qMin(2 * x + 1, source.width() - 1);
+            const QRgb p[4] = { line0[x0], line0[x1], line1[x0], line1[x1] };
+
+            int a = 0, r = 0, g = 0, b = 0;
+            for (const QRgb &c : p) {
+                a += qAlpha(c);
+                r += qRed(c);
+                g += qGreen(c);
+                b += qBlue(c);
+            }
+
+            dst[x] = qRgba((r + 2) / 4, (g + 2) / 4, (b + 2) / 4, (a + 2) / 4);
+        }
+    }
+
+    return target;
+}
+
+/**
+ * @brief mipScaledPixmap 从当前mip级别逐级box滤波缩小, 直到不小于目标尺寸的最后一级, 再平滑缩放到目标尺寸
+ * @param level 当前mip级别, 调用后更新为本次使用的级别, 多个尺寸按从大到小的顺序调用时共用同一条mip链
+ * @param size 图标逻辑大小
+ * @return 按当前设备像素比缩放后的图标
+ */
+QPixmap mipScaledPixmap(QImage &level, const int size)
+{
+    const qreal ratio = qApp->devicePixelRatio();
+    const QSize targetSize = QSize(size, size) * ratio;
+
+    while (level.width() / 2 >= targetSize.width() && level.height() / 2 >= targetSize.height())
+        level = boxDownsample(level);
+
+    QPixmap pixmap = QPixmap::fromImage(level.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    pixmap.setDevicePixelRatio(ratio);
+
+    return pixmap;
+}
+
 /**
  * @brief getIcon 根据传入的\a name 参数重新从系统主题中获取一次图标
  * @param name 图标名
@@ -449,9 +529,63 @@ QIcon getIcon(const QString &name)
     return QIcon::fromTheme(getIconList(name).first());
 }
 
+static QReadWriteLock IconSourceLock;
+static QHash<QString, QString> IconSourceKeys;
+
+/**
+ * @brief iconSourceKey 将应用的图标字段解析为图标来源标识
+ * 文件路径解析为规范化的绝对路径, 内嵌图片数据取其摘要, 其余按主题图标名处理
+ * @param iconKey 应用desktop文件中的Icon字段
+ * @return 图标来源标识
+ */
+static QString iconSourceKey(const QString &iconKey)
+{
+    {
+        QReadLocker locker(&IconSourceLock);
+        auto it = IconSourceKeys.constFind(iconKey);
+        if (it != IconSourceKeys.constEnd())
+            return it.value();
+    }
+
+    QString sourceKey;
+    if (iconKey.startsWith("data:image/")) {
+        sourceKey = "data:" + QCryptographicHash::hash(iconKey.toLatin1(), QCryptographicHash::Md5).toHex();
+    } else if (QFile::exists(iconKey)) {
+        const QString canonicalPath = QFileInfo(iconKey).canonicalFilePath();
+        sourceKey = "file:" + (canonicalPath.isEmpty() ? iconKey : canonicalPath);
+    } else {
+        sourceKey = "theme:" + iconKey;
+    }
+
+    QWriteLocker locker(&IconSourceLock);
+    IconSourceKeys.insert(iconKey, sourceKey);
+
+    return sourceKey;
+}
+
+/**
+ * @brief cacheKey 获取应用图标在缓存中的键值
+ * 键值由解析后的图标来源与渲染参数组成, 与应用名称无关,
+ * 使用同一图标的多个应用共享同一份缓存, 切换语言时缓存也无需重建
+ * @param itemInfo 应用程序信息
+ * @return 缓存键值
+ */
 QString cacheKey(const ItemInfo &itemInfo)
 {
-    return itemInfo.m_name + itemInfo.m_iconKey;
+    return iconSourceKey(itemInfo.m_iconKey) + "@" + QString::number(qApp->devicePixelRatio());
+}
+
+/**
+ * @brief resetCacheKeys 清空图标来源的解析结果, 图标主题变化或者应用更新时调用
+ * @param iconKey 需要清除的图标字段, 为空时全部清除
+ */
+void resetCacheKeys(const QString &iconKey)
+{
+    QWriteLocker locker(&IconSourceLock);
+    if (iconKey.isEmpty())
+        IconSourceKeys.clear();
+    else
+        IconSourceKeys.remove(iconKey);
 }
 
 /**
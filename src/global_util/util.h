@@ -26,7 +26,11 @@ QVariant SettingValue(const QString &schema_id, const QByteArray &path = QByteAr
 bool createCalendarIcon(const QString &fileName);
 int perfectIconSize(const int size);
 QString cacheKey(const ItemInfo &itemInfo);
+void resetCacheKeys(const QString &iconKey = QString());
 bool getThemeIcon(QPixmap &pixmap, const ItemInfo &itemInfo, const int size, bool reObtain);
+bool isVectorIconSource(const ItemInfo &itemInfo);
+QImage boxDownsample(const QImage &image);
+QPixmap mipScaledPixmap(QImage &level, const int size);
 QIcon getIcon(const QString &name);
 QVariant getDConfigValue(const QString &key, const QVariant &defaultValue, const QString &configFileName = DLauncher::DEFAULT_META_CONFIG_NAME);
 bool isWaylandDisplay();
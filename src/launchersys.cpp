@@ -10,6 +10,8 @@
 #include "global_util/util.h"
 #include "constants.h"
 #include "iconcachemanager.h"
+#include "idlemode.h"
+#include "displaytopology.h"
 
 #define SessionManagerService "com.deepin.SessionManager"
 #define SessionManagerPath "/com/deepin/SessionManager"
@@ -30,7 +32,6 @@ LauncherSys::LauncherSys(QObject *parent)
     , m_autoExitTimer(new QTimer(this))
     , m_ignoreRepeatVisibleChangeTimer(new QTimer(this))
     , m_calcUtil(CalculateUtil::instance())
-    , m_dockInter(new DBusDock(this))
     , m_clicked(false)
 {
     m_regionMonitor->setCoordinateType(DRegionMonitor::Original);
@@ -45,11 +46,16 @@ LauncherSys::LauncherSys(QObject *parent)
     connect(m_dbusLauncherInter, &DBusLauncher::FullscreenChanged, this, &LauncherSys::displayModeChanged, Qt::QueuedConnection);
     connect(m_dbusLauncherInter, &DBusLauncher::DisplayModeChanged, this, &LauncherSys::onDisplayModeChanged, Qt::QueuedConnection);
     connect(m_autoExitTimer, &QTimer::timeout, this, &LauncherSys::onAutoExitTimeout, Qt::QueuedConnection);
-    connect(m_dockInter, &DBusDock::FrontendRectChanged, this, &LauncherSys::onFrontendRectChanged);
+    // 等待拓扑缓存拿到任务栏新位置后再跟随显示，避免按旧位置重新布局
+    connect(DisplayTopology::instance(), &DisplayTopology::dockRectChanged, this, &LauncherSys::onFrontendRectChanged, Qt::QueuedConnection);
     connect(IconCacheManager::instance(), &IconCacheManager::iconLoaded, this, &LauncherSys::aboutToShowLauncher, Qt::QueuedConnection);
-    connect(IconCacheManager::instance(), &IconCacheManager::iconLoaded, this, &LauncherSys::updateLauncher);
+    connect(IconCacheManager::instance(), &IconCacheManager::iconLoaded, this, &LauncherSys::updateLauncher, Qt::QueuedConnection);
 
     m_autoExitTimer->start();
+
+    // 启动后未显示时即进入空闲状态
+    if (!visible())
+        IdleMode::instance()->enter();
 }
 
 LauncherSys::~LauncherSys()
@@ -78,6 +84,9 @@ void LauncherSys::showLauncher()
 
     m_ignoreRepeatVisibleChangeTimer->start();
 
+    // 收到显示请求后先处理隐藏期间记录的任务, 图标尚未加载完成时同样提前处理
+    IdleMode::instance()->leave();
+
     if (IconCacheManager::iconLoadState()) {
         m_autoExitTimer->stop();
         registerRegion();
@@ -188,11 +197,15 @@ void LauncherSys::onAutoExitTimeout()
 
 bool LauncherSys::eventFilter(QObject *watched, QEvent *event)
 {
+    if (event->type() == QEvent::Show && (watched == m_fullLauncher || watched == m_windowLauncher))
+        IdleMode::instance()->leave();
+
     if (event->type() == QEvent::Hide && (watched == m_fullLauncher || watched == m_windowLauncher)) {
         m_regionMonitor->unregisterRegion();
         disconnect(m_regionMonitorConnect);
         m_autoExitTimer->start();
         setClickState(false);
+        IdleMode::instance()->enter();
     }
 
     return QObject::eventFilter(watched, event);
@@ -232,15 +245,16 @@ void LauncherSys::onButtonPress(const QPoint &p, const int flag)
     m_launcherInter->regionMonitorPoint(p, flag);
 }
 
+/**
+ * @brief LauncherSys::updateLauncher 小窗口资源加载完成后整体刷新一次,
+ * 全屏模式由模型按图标只刷新对应的应用项
+ */
 void LauncherSys::updateLauncher()
 {
-    if (!m_launcherInter->visible())
+    if (!m_launcherInter || !m_launcherInter->visible() || m_launcherInter != m_windowLauncher)
         return;
 
-    if (m_launcherInter == m_fullLauncher)
-        m_fullLauncher->update();
-    else
-        m_windowLauncher->update();
+    m_windowLauncher->update();
 }
 
 void LauncherSys::aboutToShowLauncher()
@@ -71,7 +71,6 @@ private:
     QTimer *m_ignoreRepeatVisibleChangeTimer;               // 添加200ms延时操作，避开重复显示、隐藏启动器
     QMetaObject::Connection m_regionMonitorConnect;         // 信号和槽连接返回的对象
     CalculateUtil *m_calcUtil;                              // 界面布局计算处理类
-    DBusDock *m_dockInter;
     bool m_clicked;                                         // 人的点击操作状态
 };
 
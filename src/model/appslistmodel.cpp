@@ -4,10 +4,12 @@
 
 #include "appslistmodel.h"
 #include "appsmanager.h"
+#include "iconcachemanager.h"
 #include "calculate_util.h"
 #include "constants.h"
 #include "dbusvariant/iteminfo.h"
 #include "util.h"
+#include "skinassetcache.h"
 
 #include <QSize>
 #include <QDebug>
@@ -15,6 +17,7 @@
 #include <QSettings>
 #include <QGSettings>
 #include <QVariant>
+#include <QSet>
 
 #include <DHiDPIHelper>
 #include <DGuiApplicationHelper>
@@ -214,6 +217,37 @@ AppsListModel::AppsListModel(const AppCategory &category, QObject *parent)
     connect(m_appsManager, &AppsManager::dataChanged, this, &AppsListModel::dataChanged);
     connect(m_appsManager, &AppsManager::layoutChanged, this, &AppsListModel::layoutChanged);
     connect(m_appsManager, &AppsManager::itemDataChanged, this, &AppsListModel::itemDataChanged);
+    connect(IconCacheManager::instance(), &IconCacheManager::iconsLoaded, this, &AppsListModel::iconsLoaded, Qt::QueuedConnection);
+
+    // 模型数据变化后，绘制快照需要重新构建, 行结构变化后应用key索引同样需要重建
+    connect(this, &QAbstractItemModel::dataChanged, this, [ this ](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+        invalidateRenderSnapshots(topLeft, bottomRight);
+    });
+    connect(this, &QAbstractItemModel::layoutChanged, this, [ this ] { invalidateRenderSnapshots(); m_keyRowsValid = false; });
+    connect(this, &QAbstractItemModel::modelReset, this, [ this ] { invalidateRenderSnapshots(); m_keyRowsValid = false; });
+    connect(this, &QAbstractItemModel::rowsInserted, this, [ this ] { invalidateRenderSnapshots(); m_keyRowsValid = false; });
+    connect(this, &QAbstractItemModel::rowsRemoved, this, [ this ] { invalidateRenderSnapshots(); m_keyRowsValid = false; });
+
+    // 应用数据变化时不一定通知到当前分类的模型, 收到任意分类的变化都使索引失效
+    connect(m_appsManager, &AppsManager::dataChanged, this, [ this ] { m_keyRowsValid = false; });
+    connect(m_appsManager, &AppsManager::layoutChanged, this, [ this ] { m_keyRowsValid = false; });
+    connect(m_appsManager, &AppsManager::categoryListChanged, this, [ this ] { m_keyRowsValid = false; });
+}
+
+/**
+ * @brief AppsListModel::setPageIndex 设置模型对应的分页, 分页变化时重置模型
+ * @param pageIndex 分页索引
+ */
+void AppsListModel::setPageIndex(int pageIndex)
+{
+    if (m_pageIndex == pageIndex) {
+        invalidateRenderSnapshots();
+        return;
+    }
+
+    beginResetModel();
+    m_pageIndex = pageIndex;
+    endResetModel();
 }
 
 void AppsListModel::setCategory(const AppsListModel::AppCategory category)
@@ -294,6 +328,37 @@ void AppsListModel::clearDraggingIndex()
 }
 
 
+/**
+ * @brief AppsListModel::iconsLoaded 图标加载完成后只刷新使用这些图标的应用项
+ * @param iconKeys 新加载的图标缓存键值及大小
+ */
+void AppsListModel::iconsLoaded(const QList<QPair<QString, int>> &iconKeys)
+{
+    if (!m_keyRowsValid)
+        rebuildKeyRows();
+
+    const int iconSize = perfectIconSize(m_calcUtil->appIconSize().width());
+    const int listIconSize = (m_category == Category) ? perfectIconSize(DLauncher::APP_CATEGORY_ICON_SIZE) : iconSize;
+    const int count = rowCount(QModelIndex());
+
+    // 同一图标可能被多个应用使用, 且同一批次中可能包含多个尺寸, 每行只刷新一次
+    QSet<int> changedRows;
+    for (const QPair<QString, int> &iconKey : iconKeys) {
+        if (iconKey.second != iconSize && iconKey.second != listIconSize)
+            continue;
+
+        for (auto it = m_iconRows.constFind(iconKey.first); it != m_iconRows.constEnd() && it.key() == iconKey.first; ++it) {
+            if (it.value() < count)
+                changedRows.insert(it.value());
+        }
+    }
+
+    for (const int row : changedRows) {
+        const QModelIndex modelIndex = index(row);
+        emit QAbstractItemModel::dataChanged(modelIndex, modelIndex, { AppIconRole, AppListIconRole });
+    }
+}
+
 /**
  * @brief AppsListModel::rowCount
  * 全屏时返回当前页面item的个数
@@ -319,19 +384,67 @@ int AppsListModel::rowCount(const QModelIndex &parent) const
 /**
  * @brief AppsListModel::indexAt 根据appkey值返回app所在的模型索引
  * @param appKey app key
- * @return 根据appkey值,返回app对应的模型索引
+ * @return 根据appkey值,返回app对应的模型索引, 当前页面中不存在时返回无效索引
  */
 const QModelIndex AppsListModel::indexAt(const QString &appKey) const
 {
-    int i = 0;
-    const int count = rowCount(QModelIndex());
-    while (i != count) {
-        if (index(i).data(AppKeyRole).toString() == appKey)
-            return index(i);
-        ++i;
+    const int row = rowOfKey(appKey);
+    return row < 0 ? QModelIndex() : index(row);
+}
+
+/**
+ * @brief AppsListModel::rowOfKey 通过应用key索引查找应用所在的行
+ * 索引中记录的行与当前数据不一致, 或未找到且行数已变化时(数据变化尚未通知到模型)重建索引后再查找一次
+ * @param appKey app key
+ * @return 应用所在的行, 不存在时返回-1
+ */
+int AppsListModel::rowOfKey(const QString &appKey) const
+{
+    if (!m_keyRowsValid)
+        rebuildKeyRows();
+
+    const int row = m_keyRows.value(appKey, -1);
+    if (row < 0) {
+        if (m_keyRowsCount == rowCount(QModelIndex()))
+            return -1;
+
+        rebuildKeyRows();
+        return m_keyRows.value(appKey, -1);
     }
 
-    Q_UNREACHABLE();
+    const int start = m_calcUtil->appPageItemCount(m_category) * m_pageIndex;
+    if (row < rowCount(QModelIndex()) && m_appsManager->appsInfoListIndex(m_category, start + row).m_key == appKey)
+        return row;
+
+    rebuildKeyRows();
+    return m_keyRows.value(appKey, -1);
+}
+
+/**
+ * @brief AppsListModel::rebuildKeyRows 重建当前页面应用key及图标缓存键到行号的索引
+ */
+void AppsListModel::rebuildKeyRows() const
+{
+    m_keyRows.clear();
+    m_iconRows.clear();
+    m_keyRowsValid = true;
+
+    const int count = rowCount(QModelIndex());
+    m_keyRowsCount = count;
+    if (count == 0)
+        return;
+
+    const int start = m_calcUtil->appPageItemCount(m_category) * m_pageIndex;
+    const ItemInfoList itemList = m_appsManager->appsInfoList(m_category);
+    const int end = qMin(start + count, itemList.size());
+
+    m_keyRows.reserve(end - start);
+    m_iconRows.reserve(end - start);
+    for (int i = start; i < end; i++) {
+        const ItemInfo &info = itemList.at(i);
+        m_keyRows.insert(info.m_key, i - start);
+        m_iconRows.insert(cacheKey(info), i - start);
+    }
 }
 
 void AppsListModel::setDrawBackground(bool draw)
@@ -435,6 +548,8 @@ QVariant AppsListModel::data(const QModelIndex &index, int role) const
     const ItemInfo &itemInfo = m_appsManager->appsInfoListIndex(m_category, start + index.row());
 
     switch (role) {
+    case AppRenderSnapshotRole:
+        return QVariant::fromValue(renderSnapshot(index, itemInfo));
     case AppRawItemInfoRole:
         return QVariant::fromValue(itemInfo);
     case AppNameRole:
@@ -491,9 +606,9 @@ QVariant AppsListModel::data(const QModelIndex &index, int role) const
         return indexDragging(index);
     case CategoryEnterIconRole:
         if (DGuiApplicationHelper::instance()->themeType() == DGuiApplicationHelper::LightType) {
-            return DHiDPIHelper::loadNxPixmap(":/widgets/images/enter_details_normal-dark.svg");
+            return SkinAssetCache::nxPixmap(":/widgets/images/enter_details_normal-dark.svg");
         } else {
-            return DHiDPIHelper::loadNxPixmap(":/widgets/images/enter_details_normal.svg");
+            return SkinAssetCache::nxPixmap(":/widgets/images/enter_details_normal.svg");
         }
     case DrawBackgroundRole:
         return m_drawBackground;
@@ -588,16 +703,70 @@ bool AppsListModel::indexDragging(const QModelIndex &index) const
  */
 void AppsListModel::itemDataChanged(const ItemInfo &info)
 {
-    int i = 0;
-    const int count = rowCount(QModelIndex());
-    while (i != count) {
-        if (index(i).data(AppKeyRole).toString() == info.m_key) {
-            const QModelIndex modelIndex = index(i);
-            emit QAbstractItemModel::dataChanged(modelIndex, modelIndex);
-            return;
-        }
-        ++i;
+    // 分类列表中是分类项, 具体分类的模型只包含该分类的应用, 无关的模型不需要查找
+    if (m_category == Category || (m_category > Category && info.category() != m_category))
+        return;
+
+    const int row = rowOfKey(info.m_key);
+    if (row < 0)
+        return;
+
+    const QModelIndex modelIndex = index(row);
+    emit QAbstractItemModel::dataChanged(modelIndex, modelIndex);
+}
+
+/**
+ * @brief AppsListModel::renderSnapshot 获取应用项的绘制快照
+ * 快照在首次绘制时构建并缓存，数据变化时失效，拖拽状态和字体大小每次实时获取
+ * @param index 应用项的模型索引
+ * @param itemInfo 应用信息
+ * @return 应用项的绘制快照
+ */
+const AppRenderSnapshot AppsListModel::renderSnapshot(const QModelIndex &index, const ItemInfo &itemInfo) const
+{
+    AppRenderSnapshot snapshot;
+
+    auto it = m_renderSnapshots.constFind(index.row());
+    if (it != m_renderSnapshots.constEnd() && it.value().key == itemInfo.m_key) {
+        snapshot = it.value();
+    } else {
+        snapshot.key = itemInfo.m_key;
+        snapshot.name = itemInfo.m_name;
+        snapshot.iconSize = m_calcUtil->appIconSize();
+        snapshot.icon = m_appsManager->appIcon(itemInfo, snapshot.iconSize.width());
+        snapshot.group = m_category;
+        snapshot.category = itemInfo.category();
+        snapshot.newInstall = data(index, AppNewInstallRole).toBool();
+        snapshot.autoStart = m_category != Category ? m_appsManager->appIsAutoStart(itemInfo.m_desktop) : false;
+
+        // 图标未加载完成(为空或返回了默认的齿轮图标)时不缓存，下次绘制时重新获取
+        const QPixmap fallbackIcon = SkinAssetCache::fallbackAppIcon(perfectIconSize(snapshot.iconSize.width()));
+        if (!snapshot.icon.isNull() && snapshot.icon.cacheKey() != fallbackIcon.cacheKey())
+            m_renderSnapshots.insert(index.row(), snapshot);
+    }
+
+    snapshot.fontPixelSize = DFontSizeManager::instance()->fontPixelSize(DFontSizeManager::T6);
+    snapshot.dragging = indexDragging(index);
+
+    return snapshot;
+}
+
+/**
+ * @brief AppsListModel::invalidateRenderSnapshots 清除指定范围内应用项的绘制快照
+ * @param topLeft 起始模型索引，无效时清除全部
+ * @param bottomRight 结束模型索引，无效时清除全部
+ */
+void AppsListModel::invalidateRenderSnapshots(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    if (!topLeft.isValid() || !bottomRight.isValid()) {
+        m_renderSnapshots.clear();
+        return;
     }
+
+    const int first = qMin(topLeft.row(), bottomRight.row());
+    const int last = qMax(topLeft.row(), bottomRight.row());
+    for (int row = first; row <= last; row++)
+        m_renderSnapshots.remove(row);
 }
 
 //bool AppsListModel::itemIsRemovable(const QString &desktop) const
@@ -6,6 +6,8 @@
 #define APPSLISTMODEL_H
 
 #include <QAbstractListModel>
+#include <QHash>
+#include <QPixmap>
 
 #define MAXIMUM_POPULAR_ITEMS 11
 
@@ -13,6 +15,24 @@ class AppsManager;
 class CalculateUtil;
 class ItemInfo;
 class QGSettings;
+
+/**
+ * @brief The AppRenderSnapshot struct
+ * 应用项绘制所需数据的快照, 由模型在数据变化后构建一次, 绘制时通过一次查询获取
+ */
+struct AppRenderSnapshot {
+    QString key;                // 应用key
+    QString name;               // 应用名称
+    QPixmap icon;               // 应用图标
+    QSize iconSize;             // 图标大小
+    int fontPixelSize = 0;      // 字体像素大小
+    int group = 0;              // 模型分类
+    int category = 0;           // 应用所属分类
+    bool newInstall = false;    // 是否新安装
+    bool autoStart = false;     // 是否开机自启动
+    bool dragging = false;      // 是否处于拖拽中
+};
+
 class AppsListModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -56,7 +76,8 @@ public:
         AppCanSendToDesktopRole,
         AppCanSendToDockRole,
         AppCanStartUpRole,
-        AppCanOpenProxyRole
+        AppCanOpenProxyRole,
+        AppRenderSnapshotRole
     };
 
     enum AppCategory {
@@ -81,7 +102,8 @@ public:
 
 public:
     explicit AppsListModel(const AppCategory& category, QObject *parent = nullptr);
-    void setPageIndex(int pageIndex){m_pageIndex = pageIndex;}
+    void setPageIndex(int pageIndex);
+    inline int pageIndex() const {return m_pageIndex;}
 
     inline AppCategory category() const {return m_category;}
     void setDraggingIndex(const QModelIndex &index);
@@ -98,6 +120,7 @@ public:
 public slots:
     void clearDraggingIndex();
     void setCategory(const AppCategory category);
+    void iconsLoaded(const QList<QPair<QString, int>> &iconKeys);
 
 protected:
     bool removeRows(int row, int count, const QModelIndex &parent) Q_DECL_OVERRIDE;
@@ -111,6 +134,10 @@ private:
     void layoutChanged(const AppsListModel::AppCategory category);
     bool indexDragging(const QModelIndex &index) const;
     void itemDataChanged(const ItemInfo &info);
+    const AppRenderSnapshot renderSnapshot(const QModelIndex &index, const ItemInfo &itemInfo) const;
+    void invalidateRenderSnapshots(const QModelIndex &topLeft = QModelIndex(), const QModelIndex &bottomRight = QModelIndex());
+    int rowOfKey(const QString &appKey) const;
+    void rebuildKeyRows() const;
 //    bool itemIsRemovable(const QString &desktop) const;
 
 private:
@@ -139,9 +166,16 @@ private:
 
     bool m_drawBackground;
     int m_pageIndex;
+
+    mutable QHash<int, AppRenderSnapshot> m_renderSnapshots;
+    mutable QHash<QString, int> m_keyRows;                  // 当前页面应用key到行号的索引, 行结构变化后重建
+    mutable QMultiHash<QString, int> m_iconRows;            // 当前页面图标缓存键到行号的索引, 与 m_keyRows 一同重建
+    mutable bool m_keyRowsValid = false;
+    mutable int m_keyRowsCount = 0;                         // 建立索引时的行数
 };
 typedef QList<AppsListModel *> PageAppsModelist;
 
 Q_DECLARE_METATYPE(AppsListModel::AppCategory)
+Q_DECLARE_METATYPE(AppRenderSnapshot)
 
 #endif // APPSLISTMODEL_H
@@ -7,6 +7,10 @@
 #include "constants.h"
 #include "calculate_util.h"
 #include "iconcachemanager.h"
+#include "skinassetcache.h"
+#include "displaytopology.h"
+#include "dayrolloverscheduler.h"
+#include "idlemode.h"
 
 #include <QDebug>
 #include <QX11Info>
@@ -128,8 +132,6 @@ AppsManager::AppsManager(QObject *parent) :
     m_calUtil(CalculateUtil::instance()),
     m_searchTimer(new QTimer(this)),
     m_delayRefreshTimer(new QTimer(this)),
-    m_RefreshCalendarIconTimer(new QTimer(this)),
-    m_lastShowDate(0),
     m_tryNums(0),
     m_tryCount(0),
     m_itemInfo(ItemInfo()),
@@ -138,7 +140,9 @@ AppsManager::AppsManager(QObject *parent) :
     m_trashIsEmpty(false),
     m_fsWatcher(new QFileSystemWatcher(this)),
     m_iconCacheThread(new QThread(this)),
-    m_updateCalendarTimer(new QTimer(this))
+    m_refreshDataPending(false),
+    m_dataChangedPending(false),
+    m_trashStatePending(false)
 {
     if (QGSettings::isSchemaInstalled("com.deepin.dde.launcher")) {
         m_filterSetting = new QGSettings("com.deepin.dde.launcher", "/com/deepin/dde/launcher/");
@@ -176,9 +180,6 @@ AppsManager::AppsManager(QObject *parent) :
 
     m_iconCacheManager = IconCacheManager::instance();
 
-    m_updateCalendarTimer->setInterval(1000);// 1s
-    m_updateCalendarTimer->start();
-
     // 启动应用图标和应用名称缓存线程,减少系统加载应用时的开销
     if (getDConfigValue("preloadAppsIcon", true).toBool()) {
         m_iconCacheManager->moveToThread(m_iconCacheThread);
@@ -207,7 +208,11 @@ AppsManager::AppsManager(QObject *parent) :
 
     connect(qApp, &QCoreApplication::aboutToQuit, this, &AppsManager::stopThread, Qt::QueuedConnection);
     connect(qApp, &QCoreApplication::aboutToQuit, m_iconCacheManager, &IconCacheManager::deleteLater);
-    connect(m_updateCalendarTimer, &QTimer::timeout, m_iconCacheManager, &IconCacheManager::updateCanlendarIcon, Qt::QueuedConnection);
+
+    // 日期变化时更新日历图标并刷新列表, 不再每秒检查日期
+    connect(DayRolloverScheduler::instance(), &DayRolloverScheduler::dayChanged, m_iconCacheManager, &IconCacheManager::updateCanlendarIcon, Qt::QueuedConnection);
+    connect(DayRolloverScheduler::instance(), &DayRolloverScheduler::dayChanged, this, &AppsManager::scheduleRefreshData);
+    connect(IdleMode::instance(), &IdleMode::idleChanged, this, &AppsManager::onIdleChanged);
 
     updateTrashState();
     refreshAllList();
@@ -218,16 +223,13 @@ AppsManager::AppsManager(QObject *parent) :
     m_delayRefreshTimer->setSingleShot(true);
     m_delayRefreshTimer->setInterval(500);
 
-    m_RefreshCalendarIconTimer->setInterval(1000);
-    m_RefreshCalendarIconTimer->setSingleShot(false);
-
     connect(qApp, &DApplication::iconThemeChanged, this, &AppsManager::onIconThemeChanged, Qt::QueuedConnection);
     connect(m_launcherInter, &DBusLauncher::NewAppLaunched, this, &AppsManager::markLaunched);
     connect(m_launcherInter, &DBusLauncher::UninstallSuccess, this, &AppsManager::abandonStashedItem);
     connect(m_launcherInter, &DBusLauncher::UninstallFailed, [this](const QString & appKey) { restoreItem(appKey); emit dataChanged(AppsListModel::All); });
     connect(m_launcherInter, &DBusLauncher::ItemChanged, this, &AppsManager::handleItemChanged);
     connect(m_dockInter, &DBusDock::IconSizeChanged, this, &AppsManager::IconSizeChanged, Qt::QueuedConnection);
-    connect(m_dockInter, &DBusDock::FrontendRectChanged, this, &AppsManager::dockGeometryChanged, Qt::QueuedConnection);
+    connect(DisplayTopology::instance(), &DisplayTopology::dockRectChanged, this, &AppsManager::dockGeometryChanged, Qt::QueuedConnection);
     connect(m_startManagerInter, &DBusStartManager::AutostartChanged, this, &AppsManager::refreshAppAutoStartCache);
     connect(m_delayRefreshTimer, &QTimer::timeout, this, &AppsManager::delayRefreshData);
     connect(m_searchTimer, &QTimer::timeout, this, &AppsManager::onSearchTimeOut);
@@ -236,10 +238,6 @@ AppsManager::AppsManager(QObject *parent) :
 
     onThemeTypeChanged(DGuiApplicationHelper::instance()->themeType());
     connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, this, &AppsManager::onThemeTypeChanged);
-    connect(m_RefreshCalendarIconTimer, &QTimer::timeout, this, &AppsManager::onRefreshCalendarTimer);
-
-    if (!m_RefreshCalendarIconTimer->isActive())
-        m_RefreshCalendarIconTimer->start();
 }
 
 /**
@@ -407,12 +405,12 @@ void AppsManager::restoreItem(const QString &appKey, const int pos)
 
 int AppsManager::dockPosition() const
 {
-    return m_dockInter->position();
+    return DisplayTopology::instance()->dockPosition();
 }
 
 QRect AppsManager::dockGeometry() const
 {
-    return QRect(m_dockInter->frontendRect());
+    return DisplayTopology::instance()->dockRect();
 }
 
 bool AppsManager::isVaild()
@@ -514,6 +512,14 @@ void AppsManager::markLaunched(QString appKey)
     refreshUserInfoList();
 
     emit newInstallListChanged();
+
+    // 只刷新启动的应用项, 使绘制快照中的新安装标识失效
+    for (const ItemInfo &info : m_allAppInfoList) {
+        if (info.m_key == appKey) {
+            emit itemDataChanged(info);
+            break;
+        }
+    }
 }
 
 /**
@@ -537,8 +543,11 @@ void AppsManager::delayRefreshData()
  */
 void AppsManager::refreshIcon()
 {
-    // 更新单个应用信息
+    // 更新单个应用信息, 获取成功后刷新该应用项, 替换之前显示的齿轮图标
     appIcon(m_itemInfo);
+
+    if (m_iconValid)
+        emit itemDataChanged(m_itemInfo);
 }
 
 /**
@@ -565,16 +574,6 @@ void AppsManager::onThemeTypeChanged(DGuiApplicationHelper::ColorType themeType)
     generateCategoryMap();
 }
 
-void AppsManager::onRefreshCalendarTimer()
-{
-    m_curDate = QDate::currentDate();
-
-    if(m_lastShowDate != m_curDate.day()) {
-        delayRefreshData();
-        m_lastShowDate = m_curDate.day();
-    }
-}
-
 void AppsManager::onGSettingChanged(const QString &keyName)
 {
     if (keyName != "filter-keys" && keyName != "filterKeys")
@@ -750,11 +749,11 @@ const QPixmap AppsManager::appIcon(const ItemInfo &info, const int size)
 
     // 开启子线程加载应用图标时
     if (m_iconCacheThread->isRunning()) {
-        IconCacheManager::getPixFromCache(tmpKey, pix);
+        IconCacheManager::tryGet(tmpKey, pix);
     } else {
         // 如存在，优先读取缓存
-        if (IconCacheManager::existInCache(tmpKey)) {
-            IconCacheManager::getPixFromCache(tmpKey, pix);
+        if (IconCacheManager::tryGet(tmpKey, pix)) {
+            m_iconValid = true;
             return pix;
         }
 
@@ -768,10 +767,7 @@ const QPixmap AppsManager::appIcon(const ItemInfo &info, const int size)
         }
 
         // 先返回齿轮，然后继续找
-        qreal ratio = qApp->devicePixelRatio();
-        QIcon icon = QIcon(":/widgets/images/application-x-desktop.svg");
-        pix = icon.pixmap(QSize(iconSize, iconSize) * ratio);
-        pix.setDevicePixelRatio(ratio);
+        pix = SkinAssetCache::fallbackAppIcon(iconSize);
 
         if (m_tryNums < 10) {
             ++m_tryNums;
@@ -1188,7 +1184,17 @@ void AppsManager::refreshAppAutoStartCache(const QString &type, const QString &d
             APP_AUTOSTART_CACHE.remove(desktop_file_name);
         }
 
-        emit dataChanged(AppsListModel::All);
+        // 隐藏期间只记录, 显示前统一通知界面
+        if (IdleMode::instance()->isIdle()) {
+            m_dataChangedPending = true;
+            return;
+        }
+
+        // 只刷新自启动状态变化的应用项, 不再重新排布所有页面
+        for (const ItemInfo &info : m_allAppInfoList) {
+            if (info.m_desktop.split("/").last() == desktop_file_name)
+                emit itemDataChanged(info);
+        }
     }
 }
 
@@ -1299,9 +1305,56 @@ void AppsManager::handleItemChanged(const QString &operation, const ItemInfo &ap
         }
     }
 
+    scheduleRefreshData();
+}
+
+/**
+ * @brief AppsManager::scheduleRefreshData 延迟刷新应用列表, 隐藏期间只记录, 显示前统一刷新
+ */
+void AppsManager::scheduleRefreshData()
+{
+    if (IdleMode::instance()->isIdle()) {
+        m_refreshDataPending = true;
+        return;
+    }
+
     m_delayRefreshTimer->start();
 }
 
+/**
+ * @brief AppsManager::onIdleChanged 空闲状态变化, 退出空闲状态时一次性处理隐藏期间记录的刷新任务
+ * @param idle 是否处于空闲状态
+ */
+void AppsManager::onIdleChanged(bool idle)
+{
+    // 进入空闲状态时挂起定时器, 未完成的刷新留到显示前处理, 隐藏后的搜索结果不再需要
+    if (idle) {
+        if (m_delayRefreshTimer->isActive()) {
+            m_delayRefreshTimer->stop();
+            m_refreshDataPending = true;
+        }
+
+        m_searchTimer->stop();
+        return;
+    }
+
+    if (m_trashStatePending) {
+        m_trashStatePending = false;
+        updateTrashState();
+    }
+
+    // 刷新应用列表时会通知界面, 不再单独发送数据变化信号
+    if (m_refreshDataPending) {
+        m_refreshDataPending = false;
+        m_dataChangedPending = false;
+        m_delayRefreshTimer->stop();
+        delayRefreshData();
+    } else if (m_dataChangedPending) {
+        m_dataChangedPending = false;
+        emit dataChanged(AppsListModel::All);
+    }
+}
+
 QHash<AppsListModel::AppCategory, ItemInfoList> AppsManager::getAllAppInfo()
 {
     QHash<AppsListModel::AppCategory, ItemInfoList> appInfoList;
@@ -1360,18 +1413,7 @@ int AppsManager::getPageCount(const AppsListModel::AppCategory category)
 
 const QScreen *AppsManager::currentScreen()
 {
-    QRect dockRect = dockGeometry();
-
-    const auto ratio = qApp->devicePixelRatio();
-    for (auto *screen : qApp->screens()) {
-        const QRect &sg = screen->geometry();
-        const QRect &rg = QRect(sg.topLeft(), sg.size() * ratio);
-        if (rg.contains(dockRect.topLeft())) {
-            return  screen;
-        }
-    }
-
-    return qApp->primaryScreen();
+    return DisplayTopology::instance()->currentScreen();
 }
 
 int AppsManager::getVisibleCategoryCount()
@@ -1401,6 +1443,12 @@ int AppsManager::displayMode() const
 
 void AppsManager::updateTrashState()
 {
+    // 隐藏期间回收站的变化只做记录, 不再遍历目录
+    if (IdleMode::instance()->isIdle()) {
+        m_trashStatePending = true;
+        return;
+    }
+
     int trashItemsCount = 0;
     m_fsWatcher->addPath(TrashDir);
     if (QDir(TrashDirFiles).exists()) {
@@ -133,11 +133,12 @@ private slots:
     void searchDone(const QStringList &resultList);
     void markLaunched(QString appKey);
     void delayRefreshData();
+    void scheduleRefreshData();
+    void onIdleChanged(bool idle);
     void refreshIcon();
     void updateTrashState();
     bool fuzzyMatching(const QStringList& list, const QString& key);
     void onThemeTypeChanged(DGuiApplicationHelper::ColorType themeType);
-    void onRefreshCalendarTimer();
     void onGSettingChanged(const QString & keyName);
     void stopThread();
 
@@ -165,10 +166,6 @@ private:
     CalculateUtil *m_calUtil;
     QTimer *m_searchTimer;
     QTimer *m_delayRefreshTimer;                                            // 延迟刷新应用列表定时器指针对象
-    QTimer *m_RefreshCalendarIconTimer;
-
-    QDate m_curDate;
-    int m_lastShowDate;
 
     int m_tryNums;                                                          // 获取应用图标时尝试的次数
     int m_tryCount;                                                         // 超过10次停止遍历
@@ -196,7 +193,10 @@ private:
 
     IconCacheManager *m_iconCacheManager;
     QThread *m_iconCacheThread;
-    QTimer *m_updateCalendarTimer;
+
+    bool m_refreshDataPending;                                              // 隐藏期间记录的待处理任务
+    bool m_dataChangedPending;
+    bool m_trashStatePending;
 };
 
 #endif // APPSMANAGER_H
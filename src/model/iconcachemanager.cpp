@@ -6,13 +6,21 @@
 #include "appsmanager.h"
 #include "util.h"
 #include "calculate_util.h"
+#include "skinassetcache.h"
 
 #include <QIcon>
+#include <QThread>
+#include <QCoreApplication>
 
-QHash<QPair<QString, int>, QPixmap> IconCacheManager::m_iconCache = QHash<QPair<QString, int>, QPixmap>();
-QReadWriteLock IconCacheManager::m_iconLock;
+#include <algorithm>
+#include <functional>
+
+IconCacheManager::IconCacheShard IconCacheManager::m_iconShards[IconCacheManager::m_shardCount];
 
 std::atomic<bool> IconCacheManager::m_loadState;
+QMutex IconCacheManager::m_loadedLock;
+IconKeyList IconCacheManager::m_loadedIcons = IconKeyList();
+std::atomic<bool> IconCacheManager::m_flushQueued(false);
 static QList<double> ratioList = { 0.2, 0.3, 0.4, 0.5, 0.6 };
 static QList<int> sizeList = { 16, 18, 24, 32, 64, 96, 128, 256 };
 
@@ -29,6 +37,8 @@ IconCacheManager::IconCacheManager(QObject *parent)
     , m_tryCount(0)
     , m_date(QDate::currentDate())
 {
+    qRegisterMetaType<IconKeyList>("IconKeyList");
+
     setIconLoadState(false);
 }
 
@@ -61,10 +71,7 @@ void IconCacheManager::createPixmap(const ItemInfo &itemInfo, int size)
 
                 // 当desktop文件中Icon字段为空，不存在该字段或者字段内容错误时，
                 // 直接将齿轮写入缓存，避免显示为空
-                QIcon icon = QIcon(":/widgets/images/application-x-desktop.svg");
-                const qreal ratio = qApp->devicePixelRatio();
-                pixmap = icon.pixmap(QSize(iconSize, iconSize) * ratio);
-                pixmap.setDevicePixelRatio(ratio);
+                pixmap = SkinAssetCache::fallbackAppIcon(iconSize);
                 IconCacheManager::insertCache(tmpKey, pixmap);
                 return;
             }
@@ -76,27 +83,113 @@ void IconCacheManager::createPixmap(const ItemInfo &itemInfo, int size)
     }
 }
 
+/**
+ * @brief IconCacheManager::createPixmaps 一次解码生成应用所需的全部尺寸图标
+ * 以所需的最大尺寸获取一次图标(缓存中已有更大尺寸时直接复用), 其余尺寸由box滤波的mip链逐级缩小得到,
+ * 图标主题中的矢量图标在小尺寸下仍重新渲染, 以保留主题针对小尺寸优化过的资源
+ * @param itemInfo 应用信息
+ * @param sizes 需要生成的图标大小列表
+ */
+void IconCacheManager::createPixmaps(const ItemInfo &itemInfo, const QList<int> &sizes)
+{
+    if (itemInfo.m_iconKey == "dde-calendar")
+        m_calendarInfo = itemInfo;
+
+    const QString key = cacheKey(itemInfo);
+    QList<int> iconSizes;
+    for (int i = 0; i < sizes.size(); i++) {
+        const int iconSize = perfectIconSize(sizes.at(i));
+        if (!iconSizes.contains(iconSize) && !existInCache({ key, iconSize }))
+            iconSizes.append(iconSize);
+    }
+
+    if (iconSizes.isEmpty())
+        return;
+
+    std::sort(iconSizes.begin(), iconSizes.end(), std::greater<int>());
+
+    QPixmap source;
+    for (int i = DLauncher::APP_ICON_SIZE_LIST.size() - 1; i >= 0; i--) {
+        const int cachedSize = DLauncher::APP_ICON_SIZE_LIST.at(i);
+        if (cachedSize >= iconSizes.first() && tryGet({ key, cachedSize }, source))
+            break;
+    }
+
+    if (source.isNull()) {
+        createPixmap(itemInfo, iconSizes.first());
+
+        // 未获取到有效图标时, 其他尺寸等待下次加载时再重试
+        if (!tryGet({ key, iconSizes.first() }, source))
+            return;
+
+        iconSizes.removeFirst();
+    }
+
+    const bool vectorSource = isVectorIconSource(itemInfo);
+    QImage level = source.toImage();
+    for (int i = 0; i < iconSizes.size(); i++) {
+        const int iconSize = iconSizes.at(i);
+        if (vectorSource && iconSize <= DLauncher::APP_ITEM_ICON_SIZE) {
+            createPixmap(itemInfo, iconSize);
+            continue;
+        }
+
+        insertCache({ key, iconSize }, mipScaledPixmap(level, iconSize));
+    }
+}
+
 double IconCacheManager::getCurRatio()
 {
-    return SettingValue("com.deepin.dde.launcher", "/com/deepin/dde/launcher/", "apps-icon-ratio", 0.6).toDouble();
+    return CalculateUtil::instance()->iconRatio();
 }
 
-bool IconCacheManager::existInCache(const QPair<QString, int> &tmpKey)
+IconCacheManager::IconCacheShard &IconCacheManager::shard(const QPair<QString, int> &tmpKey)
+{
+    return m_iconShards[qHash(tmpKey) % m_shardCount];
+}
+
+/**
+ * @brief IconCacheManager::tryGet 单次查找缓存中的图标, 查找过程不修改缓存
+ * @param tmpKey 缓存键值
+ * @param pix 命中时返回的图标
+ * @return 缓存中存在有效图标时返回true
+ */
+bool IconCacheManager::tryGet(const QPair<QString, int> &tmpKey, QPixmap &pix)
 {
-    std::atomic<bool> exist;
+    IconCacheShard &iconShard = shard(tmpKey);
 
-    m_iconLock.lockForRead();
-    exist.store(m_iconCache.contains(tmpKey) && !m_iconCache[tmpKey].isNull());
-    m_iconLock.unlock();
+    QReadLocker locker(&iconShard.lock);
+    auto it = iconShard.cache.constFind(tmpKey);
+    if (it == iconShard.cache.constEnd() || it.value().isNull())
+        return false;
+
+    pix = it.value();
+    return true;
+}
+
+bool IconCacheManager::existInCache(const QPair<QString, int> &tmpKey)
+{
+    IconCacheShard &iconShard = shard(tmpKey);
 
-    return exist;
+    QReadLocker locker(&iconShard.lock);
+    auto it = iconShard.cache.constFind(tmpKey);
+    return it != iconShard.cache.constEnd() && !it.value().isNull();
 }
 
-void IconCacheManager::getPixFromCache(QPair<QString, int> &tmpKey, QPixmap &pix)
+/**
+ * @brief IconCacheManager::flushLoadedIcons 通知界面本批次新加载的图标，
+ * 模型据此只刷新使用这些图标的应用项
+ */
+void IconCacheManager::flushLoadedIcons()
 {
-    m_iconLock.lockForRead();
-    pix = m_iconCache[tmpKey];
-    m_iconLock.unlock();
+    IconKeyList iconKeys;
+    {
+        QMutexLocker locker(&m_loadedLock);
+        iconKeys.swap(m_loadedIcons);
+    }
+
+    if (!iconKeys.isEmpty())
+        emit iconsLoaded(iconKeys);
 }
 
 /**获取小窗口的资源
@@ -114,6 +207,7 @@ void IconCacheManager::loadWindowIcon()
     }
 
     setIconLoadState(true);
+    flushLoadedIcons();
     emit iconLoaded();
 }
 
@@ -133,9 +227,10 @@ void IconCacheManager::loadOtherIcon()
     const ItemInfoList &itemList = AppsManager::windowedFrameItemInfoList();
     for (int i = 0; i < itemList.size(); i++) {
         const ItemInfo &info = itemList.at(i);
-        createPixmap(info, DLauncher::APP_DLG_ICON_SIZE);
-        createPixmap(info, DLauncher::APP_DRAG_ICON_SIZE);
+        createPixmaps(info, { DLauncher::APP_DLG_ICON_SIZE, DLauncher::APP_DRAG_ICON_SIZE });
     }
+
+    flushLoadedIcons();
 }
 
 void IconCacheManager::loadItem(const ItemInfo &info, const QString &operationStr)
@@ -144,14 +239,14 @@ void IconCacheManager::loadItem(const ItemInfo &info, const QString &operationSt
         removeItemFromCache(info);
 
     // 小窗口
-    createPixmap(info, DLauncher::APP_ITEM_ICON_SIZE);
+    QList<int> sizes { DLauncher::APP_ITEM_ICON_SIZE };
 
     // 全屏自由
     int appSize = CalculateUtil::instance()->calculateIconSize(ALL_APPS);
     for (int i = 0; i < ratioList.size(); i++) {
         double ratio = ratioList.at(i);
         int iconWidth = (appSize * ratio);
-        createPixmap(info, iconWidth);
+        sizes.append(iconWidth);
     }
 
     // 全屏分类
@@ -159,8 +254,11 @@ void IconCacheManager::loadItem(const ItemInfo &info, const QString &operationSt
     for (int i = 0; i < ratioList.size(); i++) {
         double ratio = ratioList.at(i);
         int iconWidth = (appSize * ratio);
-        createPixmap(info, iconWidth);
+        sizes.append(iconWidth);
     }
+
+    createPixmaps(info, sizes);
+    flushLoadedIcons();
 }
 
 void IconCacheManager::loadCurRatioIcon(int mode)
@@ -174,23 +272,30 @@ void IconCacheManager::loadCurRatioIcon(int mode)
     }
 
     setIconLoadState(true);
+    flushLoadedIcons();
     emit iconLoaded();
 }
 
 void IconCacheManager::loadOtherRatioIcon(int mode)
 {
     int appSize = CalculateUtil::instance()->calculateIconSize(mode);
-    const ItemInfoList &itemList = AppsManager::fullscreenItemInfoList();
+    const double curRatio = getCurRatio();
+    QList<int> sizes;
     for (int i = 0; i < ratioList.size(); i++) {
         double ratio = ratioList.at(i);
-        if (qFuzzyCompare(getCurRatio(), ratio))
+        if (qFuzzyCompare(curRatio, ratio))
             continue;
 
-        for (int j = 0; j < itemList.size(); j++) {
-            const ItemInfo &info = itemList.at(j);
-            createPixmap(info, appSize * ratio);
-        }
+        sizes.append(appSize * ratio);
     }
+
+    const ItemInfoList &itemList = AppsManager::fullscreenItemInfoList();
+    for (int j = 0; j < itemList.size(); j++) {
+        const ItemInfo &info = itemList.at(j);
+        createPixmaps(info, sizes);
+    }
+
+    flushLoadedIcons();
 }
 
 /** 图标主题变化时，加载全屏资源
@@ -207,31 +312,59 @@ void IconCacheManager::loadFullWindowIcon()
 
 void IconCacheManager::insertCache(const QPair<QString, int> &tmpKey, const QPixmap &pix)
 {
-    m_iconLock.lockForWrite();
-    if (!m_iconCache.contains(tmpKey) || (m_iconCache.contains(tmpKey) && m_iconCache[tmpKey].isNull()))
-        m_iconCache[tmpKey] = pix;
+    IconCacheShard &iconShard = shard(tmpKey);
+
+    {
+        QWriteLocker locker(&iconShard.lock);
+        auto it = iconShard.cache.find(tmpKey);
+        if (it == iconShard.cache.end())
+            iconShard.cache.insert(tmpKey, pix);
+        else if (it.value().isNull())
+            it.value() = pix;
+        else
+            return;
+    }
+
+    // 记录新加入缓存的图标，批量加载结束后通知界面按需刷新
+    {
+        QMutexLocker locker(&m_loadedLock);
+        m_loadedIcons.append(tmpKey);
+    }
 
-    m_iconLock.unlock();
+    // 主线程中按需加载的图标不属于任何批次，在下一轮事件循环中通知界面
+    if (QThread::currentThread() == qApp->thread() && !m_flushQueued.exchange(true)) {
+        QMetaObject::invokeMethod(qApp, [] {
+            m_flushQueued = false;
+            instance()->flushLoadedIcons();
+        }, Qt::QueuedConnection);
+    }
 }
 
 void IconCacheManager::removeItemFromCache(const ItemInfo &info)
 {
+    // 缓存以图标来源为键值, 使用同一图标的应用会在重新加载时一并更新
+    const QString key = cacheKey(info);
     for (int i = 0; i < DLauncher::APP_ICON_SIZE_LIST.size(); i++) {
-        QPair<QString, int> pixKey { cacheKey(info), DLauncher::APP_ICON_SIZE_LIST.at(i) };
-        if (existInCache(pixKey)) {
-            m_iconLock.lockForWrite();
-            m_iconCache.remove(pixKey);
-            m_iconLock.unlock();
-        }
+        QPair<QString, int> pixKey { key, DLauncher::APP_ICON_SIZE_LIST.at(i) };
+        IconCacheShard &iconShard = shard(pixKey);
+
+        QWriteLocker locker(&iconShard.lock);
+        iconShard.cache.remove(pixKey);
     }
+
+    // 应用更新后图标文件可能发生变化, 下次加载时重新解析图标来源
+    resetCacheKeys(info.m_iconKey);
 }
 
 void IconCacheManager::resetIconData()
 {
     // 清缓存
-    m_iconLock.lockForWrite();
-    m_iconCache.clear();
-    m_iconLock.unlock();
+    for (int i = 0; i < m_shardCount; i++) {
+        QWriteLocker locker(&m_iconShards[i].lock);
+        m_iconShards[i].cache.clear();
+    }
+
+    resetCacheKeys();
 
     // 重置状态
     setIconLoadState(false);
@@ -252,11 +385,10 @@ void IconCacheManager::updateCanlendarIcon()
     if (m_date != QDate::currentDate()) {
         removeItemFromCache(m_calendarInfo);
 
-        for (int i = 0; i < DLauncher::APP_ICON_SIZE_LIST.size(); i++)
-            createPixmap(m_calendarInfo, DLauncher::APP_ICON_SIZE_LIST.at(i));
+        createPixmaps(m_calendarInfo, DLauncher::APP_ICON_SIZE_LIST);
 
-        // 刷新界面
-        emit iconLoaded();
+        // 只刷新日历图标所在的应用项
+        flushLoadedIcons();
         m_date = QDate::currentDate();
     }
 }
@@ -12,6 +12,9 @@
 #include <QHash>
 #include <QPixmap>
 #include <QReadWriteLock>
+#include <QMutex>
+
+typedef QList<QPair<QString, int>> IconKeyList;
 
 class IconCacheManager : public QObject
 {
@@ -23,19 +26,33 @@ public:
     static bool iconLoadState();
     static void setIconLoadState(bool state);
 
+    static bool tryGet(const QPair<QString, int> &tmpKey, QPixmap &pix);
     static bool existInCache(const QPair<QString, int> &tmpKey);
-    static void getPixFromCache(QPair<QString, int> &tmpKey, QPixmap &pix);
     static void insertCache(const QPair<QString, int> &tmpKey, const QPixmap &pix);
 
 private:
+    /**
+     * @brief The IconCacheShard struct
+     * 图标缓存分片, 每个分片独立加锁, 降低界面线程与加载线程之间的锁竞争
+     */
+    struct IconCacheShard {
+        QReadWriteLock lock;
+        QHash<QPair<QString, int>, QPixmap> cache;
+    };
+
     explicit IconCacheManager(QObject *parent = nullptr);
 
+    static IconCacheShard &shard(const QPair<QString, int> &tmpKey);
+
     void createPixmap(const ItemInfo &itemInfo, int size);
+    void createPixmaps(const ItemInfo &itemInfo, const QList<int> &sizes);
+    void flushLoadedIcons();
     void removeItemFromCache(const ItemInfo &info);
     double getCurRatio();
 
 signals:
     void iconLoaded();
+    void iconsLoaded(const IconKeyList &iconKeys);
 
 public slots:
     void loadWindowIcon();
@@ -49,9 +66,12 @@ public slots:
     void updateCanlendarIcon();
 
 private:
-    static QReadWriteLock m_iconLock;
-    static QHash<QPair<QString, int>, QPixmap> m_iconCache;
+    static const int m_shardCount = 16;
+    static IconCacheShard m_iconShards[m_shardCount];
     static std::atomic<bool> m_loadState;
+    static QMutex m_loadedLock;
+    static IconKeyList m_loadedIcons;
+    static std::atomic<bool> m_flushQueued;
 
     ItemInfo m_calendarInfo;
     bool m_iconValid;
@@ -60,4 +80,6 @@ private:
     QDate m_date;
 };
 
+Q_DECLARE_METATYPE(IconKeyList)
+
 #endif // ICONCACHEMANAGER_H
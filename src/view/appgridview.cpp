@@ -8,6 +8,7 @@
 #include "util.h"
 #include "appslistmodel.h"
 #include "fullscreenframe.h"
+#include "appitemdelegate.h"
 
 #include <DGuiApplicationHelper>
 
@@ -19,6 +20,7 @@
 #include <QtGlobal>
 #include <QDrag>
 #include <QPropertyAnimation>
+#include <QVariantAnimation>
 #include <QLabel>
 #include <QPainter>
 #include <QScrollBar>
@@ -40,6 +42,7 @@ Gesture *AppGridView::m_gestureInter = nullptr;
 AppGridView::AppGridView(QWidget *parent)
     : QListView(parent)
     , m_dropThresholdTimer(new QTimer(this))
+    , m_reorderAnimation(new QVariantAnimation(this))
     , m_pixLabel(nullptr)
     , m_calendarWidget(nullptr)
     , m_vlayout(nullptr)
@@ -64,6 +67,11 @@ AppGridView::AppGridView(QWidget *parent)
     m_dropThresholdTimer->setInterval(DLauncher::APP_DRAG_SWAP_THRESHOLD);
     m_dropThresholdTimer->setSingleShot(true);
 
+    // InOutQuad 描述起点矩形到终点矩形的速度曲线
+    m_reorderAnimation->setStartValue(0.0);
+    m_reorderAnimation->setEndValue(1.0);
+    m_reorderAnimation->setEasingCurve(QEasingCurve::Linear);
+
     viewport()->installEventFilter(this);
     viewport()->setAcceptDrops(true);
     createMovingComponent();
@@ -92,6 +100,12 @@ AppGridView::AppGridView(QWidget *parent)
         setViewportMargins(m_calcUtil->appMarginLeft(), m_calcUtil->appMarginTop(), m_calcUtil->appMarginLeft(), 0);
     });
 
+    connect(m_reorderAnimation, &QVariantAnimation::valueChanged, this, [this] {
+        m_dropThresholdTimer->stop();
+        viewport()->update(m_reorderRect);
+    });
+    connect(m_reorderAnimation, &QVariantAnimation::finished, this, &AppGridView::reorderFinished);
+
 #ifndef DISABLE_DRAG_ANIMATION
     connect(m_dropThresholdTimer, &QTimer::timeout, this, &AppGridView::prepareDropSwap);
 #else
@@ -179,7 +193,7 @@ void AppGridView::mousePressEvent(QMouseEvent *e)
         }
     }
 
-    if (e->buttons() == Qt::LeftButton && !m_lastFakeAni) {
+    if (e->buttons() == Qt::LeftButton && !isReordering()) {
         m_dragStartPos = e->pos();
 
         // 记录动画的终点位置
@@ -209,7 +223,7 @@ void AppGridView::dragMoveEvent(QDragMoveEvent *e)
     Q_UNUSED(e);
     m_dropThresholdTimer->stop();
 
-    if (m_lastFakeAni)
+    if (isReordering())
         return;
 
     const QPoint pos = e->pos();
@@ -415,39 +429,20 @@ QPixmap AppGridView::creatSrcPix(const QModelIndex &index, const QString &appKey
 }
 
 /**
- * @brief AppGridView::appIconRect 计算应用图标的矩形位置，该接口中的浮点数据
- * 是从视图代理paint接口中摘过来的matlab模拟的数据
+ * @brief AppGridView::appIconRect 获取应用图标的矩形位置，与视图代理绘制时使用同一份布局结果
  * @param index 应用图标所在的模型索引
  * @return 应用图标对应的矩形大小
  */
 QRect AppGridView::appIconRect(const QModelIndex &index)
 {
-    qreal ratio = qApp->devicePixelRatio();
-    const QSize iconSize = index.data(AppsListModel::AppIconSizeRole).toSize() * ratio;
-
-    const static double x1 = 0.26418192;
-    const static double x2 = -0.38890932;
+    AppItemDelegate *delegate = qobject_cast<AppItemDelegate *>(itemDelegate());
+    if (!delegate || !index.isValid())
+        return QRect();
 
-    const int w = indexRect(index).width();
-    const int h = indexRect(index).height();
-    const int sub = qAbs((w - h) / 2);
+    QStyleOptionViewItem option = viewOptions();
+    option.rect = indexRect(index);
 
-    QRect ibr;
-    if (w == h)
-         ibr = indexRect(index);
-    else if (w > h)
-          ibr = indexRect(index) - QMargins(sub, 0, sub, 0);
-    else
-          ibr = indexRect(index) - QMargins(0, 0, 0, sub * 2);
-
-    const double result = x1 * ibr.width() + x2 * iconSize.width();
-    int margin = result > 0 ? result * 0.71 : 1;
-    QRect br = ibr.marginsRemoved(QMargins(margin, 1, margin, margin * 2));
-
-    int iconTopMargin = 6;
-
-    const int iconLeftMargins = (br.width() - iconSize.width()) / 2;
-    return QRect(br.topLeft() + QPoint(iconLeftMargins, iconTopMargin - 2), iconSize);
+    return delegate->itemLayout(option, index).iconRect.translated(option.rect.topLeft());
 }
 
 /**
@@ -482,7 +477,7 @@ void AppGridView::startDrag(const QModelIndex &index, bool execDrag)
     QPropertyAnimation *posAni = new QPropertyAnimation(m_pixLabel.data(), "pos", m_pixLabel.data());
     connect(posAni, &QPropertyAnimation::finished, [&, listModel] () {
         m_pixLabel->hide();
-        if (!m_lastFakeAni) {
+        if (!isReordering()) {
             if (m_enableDropInside)
                 listModel->dropSwap(m_dropToPos);
             else
@@ -493,12 +488,11 @@ void AppGridView::startDrag(const QModelIndex &index, bool execDrag)
 
             listModel->clearDraggingIndex();
         } else {
-            connect(m_lastFakeAni, &QPropertyAnimation::finished, listModel, &AppsListModel::clearDraggingIndex);
+            m_clearDraggingAfterReorder = true;
         }
 
         setDropAndLastPos(QPoint(0, 0));
         m_enableDropInside = false;
-        m_lastFakeAni = nullptr;
     });
 
     m_dropToPos = index.row();
@@ -507,6 +501,9 @@ void AppGridView::startDrag(const QModelIndex &index, bool execDrag)
     int old_page = m_containerBox->property("curPage").toInt();
 
     if (execDrag) {
+        // 拖拽过程中视图及模型不能被分页复用
+        emit dragStarted();
+
         QDrag *drag = new QDrag(this);
         drag->setMimeData(model()->mimeData(QModelIndexList() << dragIndex));
         drag->setPixmap(srcPix);
@@ -566,7 +563,7 @@ void AppGridView::fitToContent()
  */
 void AppGridView::prepareDropSwap()
 {
-    if (m_lastFakeAni || m_dropThresholdTimer->isActive() || !m_enableAnimation)
+    if (isReordering() || m_dropThresholdTimer->isActive() || !m_enableAnimation)
         return;
 
     const QModelIndex dropIndex = indexAt(m_dropToPos);
@@ -599,11 +596,12 @@ void AppGridView::prepareDropSwap()
     if (start == end)
         return;
 
-    int index = 0;
-    for (int i = (start + moveToNext); i != (end - !moveToNext); ++i)
-        createFakeAnimation(i, moveToNext, index++);
+    m_reorderItems.clear();
+    m_reorderRect = QRect();
+    for (int i = (start + moveToNext); i != (end - !moveToNext) + 1; ++i)
+        addReorderItem(i, moveToNext);
 
-    createFakeAnimation(end - !moveToNext, moveToNext, index++, true);
+    startReorderAnimation();
 
     // item最后回归的位置
     setDropAndLastPos(appIconRect(dropIndex).topLeft());
@@ -612,62 +610,83 @@ void AppGridView::prepareDropSwap()
 }
 
 /**
- * @brief AppGridView::createFakeAnimation 创建列表中item移动的动画效果
+ * @brief AppGridView::isReordering 拖拽过程中app交换动画是否正在执行
+ */
+bool AppGridView::isReordering() const
+{
+    return m_reorderAnimation->state() == QAbstractAnimation::Running;
+}
+
+/**
+ * @brief AppGridView::addReorderItem 记录列表中需要移动的item及其起止位置
  * @param pos 需要移动的item当前所在的行数
  * @param moveNext item是否移动的标识
- * @param isLastAni 是最后的那个item移动的动画标识
  */
-void AppGridView::createFakeAnimation(const int pos, const bool moveNext, const int rIndex, const bool isLastAni)
+void AppGridView::addReorderItem(const int pos, const bool moveNext)
 {
-    if (rIndex >= m_floatLabels.size())
-        return;
-
     // listview n行1列,肉眼所及的都是app自动换行后的效果
     const QModelIndex index(indexAt(pos));
+    const QRect startRect = visualRect(index);
+    const QRect endRect = visualRect(indexAt(moveNext ? pos - 1 : pos + 1));
+
+    m_reorderItems.append({ QPersistentModelIndex(index), startRect.topLeft(), endRect.topLeft() });
+    m_reorderRect |= startRect | endRect;
+}
+
+/**
+ * @brief AppGridView::startReorderAnimation 所有移动的item共用一个动画时钟,
+ * 在 paintEvent 中按插值位置绘制代理缓存的图块, 不再为每个item创建控件和动画
+ */
+void AppGridView::startReorderAnimation()
+{
+    if (m_reorderItems.isEmpty())
+        return;
 
-    QLabel *floatLabel = m_floatLabels[rIndex];
-    QPropertyAnimation *ani = new QPropertyAnimation(floatLabel, "pos", floatLabel);
+    m_reorderAnimation->setDuration(DGuiApplicationHelper::isSpecialEffectsEnvironment() ? DLauncher::APP_DRAG_MININUM_TIME : 0);
+    m_reorderAnimation->start();
+}
 
-    const auto ratio = devicePixelRatioF();
-    const QSize rectSize = index.data(AppsListModel::ItemSizeHintRole).toSize();
+/**
+ * @brief AppGridView::reorderFinished 交换动画结束后交换模型数据
+ */
+void AppGridView::reorderFinished()
+{
+    m_reorderItems.clear();
+    viewport()->update(m_reorderRect);
+    m_reorderRect = QRect();
 
-    QPixmap pixmap(rectSize * ratio);
-    pixmap.fill(Qt::transparent);
-    pixmap.setDevicePixelRatio(ratio);
+    dropSwap();
 
-    QStyleOptionViewItem item;
-    item.rect = QRect(QPoint(0, 0), rectSize);
-    item.features |= QStyleOptionViewItem::HasDisplay;
+    if (m_clearDraggingAfterReorder) {
+        m_clearDraggingAfterReorder = false;
 
-    QPainter painter(&pixmap);
-    itemDelegate()->paint(&painter, item, index);
+        AppsListModel *listModel = qobject_cast<AppsListModel *>(model());
+        if (listModel)
+            listModel->clearDraggingIndex();
+    }
+}
 
-    floatLabel->setFixedSize(rectSize);
-    floatLabel->setPixmap(pixmap);
-    floatLabel->show();
+void AppGridView::paintEvent(QPaintEvent *e)
+{
+    QListView::paintEvent(e);
 
-    int topMargin = m_calcUtil->appMarginTop();
-    int leftMargin = m_calcUtil->appMarginLeft();
-    ani->setStartValue(indexRect(index).topLeft() - QPoint(0, -topMargin) + QPoint(leftMargin, 0));
-    ani->setEndValue(indexRect(indexAt(moveNext ? pos - 1 : pos + 1)).topLeft() - QPoint(0, -topMargin) + QPoint(leftMargin, 0));
+    if (!isReordering() || m_reorderItems.isEmpty())
+        return;
 
-    // InOutQuad 描述起点矩形到终点矩形的速度曲线
-    ani->setEasingCurve(QEasingCurve::Linear);
-    ani->setDuration(DLauncher::APP_DRAG_MININUM_TIME);
+    const qreal progress = m_reorderAnimation->currentValue().toReal();
 
-    if (!DGuiApplicationHelper::isSpecialEffectsEnvironment()) {
-        ani->setStartValue(ani->endValue());
-        ani->setDuration(0);
-    }
+    QPainter painter(viewport());
+    QStyleOptionViewItem option = viewOptions();
+    option.features |= QStyleOptionViewItem::HasDisplay;
 
-    connect(ani, &QPropertyAnimation::finished, floatLabel, &QLabel::hide);
-    if (isLastAni) {
-        m_lastFakeAni = ani;
-        connect(ani, &QPropertyAnimation::finished, this, &AppGridView::dropSwap);
-        connect(ani, &QPropertyAnimation::valueChanged, m_dropThresholdTimer, &QTimer::stop);
-    }
+    for (const ReorderItem &item : qAsConst(m_reorderItems)) {
+        if (!item.index.isValid())
+            continue;
 
-    ani->start(QPropertyAnimation::DeleteWhenStopped);
+        const QPoint pos = item.startPos + (item.endPos - item.startPos) * progress;
+        option.rect = QRect(pos, visualRect(item.index).size());
+        itemDelegate()->paint(&painter, option, item.index);
+    }
 }
 
 /**
@@ -681,7 +700,6 @@ void AppGridView::dropSwap()
         return;
 
     listModel->dropSwap(m_dropToPos);
-    m_lastFakeAni = nullptr;
 
     setState(NoState);
 }
@@ -703,15 +721,8 @@ void AppGridView::createMovingComponent()
         m_pixLabel->hide();
     }
 
-    // 拖拽过程中位置交换时显示的应用图标
-    if (!m_floatLabels.size()) {
-        // 单页最多28个应用
-        for (int i = 0; i < m_calcUtil->appPageItemCount(AppsListModel::All); i++) {
-            QLabel *moveLabel = new QLabel(this);
-            moveLabel->hide();
-            m_floatLabels << moveLabel;
-        }
-    }
+    // 拖拽过程中位置交换的item在视图中直接绘制, 单页最多28个应用
+    m_reorderItems.reserve(m_calcUtil->appPageItemCount(AppsListModel::All));
 
     if (!m_calendarWidget) {
         m_calendarWidget = new QWidget(this);
@@ -8,6 +8,8 @@
 #include <QListView>
 #include <QSize>
 #include <QLabel>
+#include <QVector>
+#include <QPersistentModelIndex>
 
 #include <com_deepin_daemon_gesture.h>
 
@@ -27,6 +29,7 @@ class CalculateUtil;
 class AppsListModel;
 class FullScreenFrame;
 class QVBoxLayout;
+class QVariantAnimation;
 
 class AppGridView : public QListView
 {
@@ -55,6 +58,9 @@ public:
 private:
     void createMovingComponent();
     FullScreenFrame *fullscreen();
+    bool isReordering() const;
+    void addReorderItem(const int pos, const bool moveNext);
+    void startReorderAnimation();
 
 public slots:
     void setDragAnimationEnable() {m_enableAnimation = true;}
@@ -65,6 +71,7 @@ signals:
     void requestScrollStop() const;
     void requestScrollLeft(const QModelIndex &index) const;
     void requestScrollRight(const QModelIndex &index) const;
+    void dragStarted();
     void dragEnd();
     void requestMouseRelease() const;
 
@@ -77,12 +84,13 @@ protected:
     void mousePressEvent(QMouseEvent *e) override;
     void mouseMoveEvent(QMouseEvent *e) override;
     void mouseReleaseEvent(QMouseEvent *e) override;
+    void paintEvent(QPaintEvent *e) override;
 
 private slots:
     void dropSwap();
     void fitToContent();
     void prepareDropSwap();
-    void createFakeAnimation(const int pos, const bool moveNext, const int rIndex, const bool isLastAni = false);
+    void reorderFinished();
 
 private:
     int m_dropToPos;
@@ -92,7 +100,8 @@ private:
 
     const QWidget *m_containerBox = nullptr;
     QTimer *m_dropThresholdTimer;                        // 推拽过程中app交互动画定时器对象
-    QPropertyAnimation *m_lastFakeAni = nullptr;         // 推拽过程中app交换动画对象
+    QVariantAnimation *m_reorderAnimation;               // 推拽过程中app交换动画, 所有移动的item共用一个动画时钟
+    bool m_clearDraggingAfterReorder = false;            // 交换动画结束后是否清除拖拽状态
     static Gesture *m_gestureInter;
     DragPageDelegate *m_pDelegate;
 
@@ -105,7 +114,14 @@ private:
     QPoint m_dragStartPos;                               // 拖拽起点坐标
 
     QScopedPointer<QLabel> m_pixLabel;
-    QList<QLabel *> m_floatLabels;
+
+    struct ReorderItem {
+        QPersistentModelIndex index;
+        QPoint startPos;
+        QPoint endPos;
+    };
+    QVector<ReorderItem> m_reorderItems;                 // 交换动画中移动的item及其起止位置
+    QRect m_reorderRect;                                 // 交换动画需要重绘的区域
 
     QWidget *m_calendarWidget;
     QVBoxLayout *m_vlayout;
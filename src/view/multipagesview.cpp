@@ -74,6 +74,9 @@ MultiPagesView::MultiPagesView(AppsListModel::AppCategory categoryModel, QWidget
     connect(m_appListArea, &AppListArea::increaseIcon, this, [ = ] { if (m_calcUtil->increaseIconSize()) emit m_appsManager->layoutChanged(AppsListModel::All); });
     connect(m_appListArea, &AppListArea::decreaseIcon, this, [ = ] { if (m_calcUtil->decreaseIconSize()) emit m_appsManager->layoutChanged(AppsListModel::All); });
     connect(m_pageControl, &PageControl::onPageChanged, this, &MultiPagesView::showCurrentPage);
+    connect(m_pageSwitchAnimation, &QPropertyAnimation::finished, this, [ = ] {
+        setGradientVisible(false);
+    });
 }
 
 MultiPagesView::~MultiPagesView()
@@ -126,6 +129,7 @@ void MultiPagesView::updateGradient(QPixmap &pixmap, QPoint topLeftImg, QPoint t
 
 /**
  * @brief MultiPagesView::updatePageCount 更新分页控件信息
+ * 每一页只创建轻量的占位控件, 视图和模型只保留当前页及相邻两页, 翻页时重新绑定到对应分页
  * @param category 应用分类类型
  */
 void MultiPagesView::updatePageCount(AppsListModel::AppCategory category)
@@ -140,54 +144,116 @@ void MultiPagesView::updatePageCount(AppsListModel::AppCategory category)
 
     if (pageCount > m_pageCount) {
         while (pageCount > m_pageCount) {
-            AppsListModel *pModel = new AppsListModel(m_category);
-            pModel->setPageIndex(m_pageCount);
-            m_pageAppsModelList.push_back(pModel);
+            QWidget *pageFrame = new QWidget;
+            pageFrame->setAttribute(Qt::WA_TranslucentBackground);
+            m_pageFrames.push_back(pageFrame);
 
-            AppGridView *pageView = new AppGridView(this);
-            pageView->setModel(pModel);
-            pageView->setItemDelegate(m_delegate);
-            pageView->setContainerBox(m_appListArea);
-            pageView->installEventFilter(this);
-            pageView->setDelegate(this);
-            m_appGridViewList.push_back(pageView);
-
-            m_viewBox->layout()->insertWidget(m_pageCount, pageView);
+            m_viewBox->layout()->insertWidget(m_pageCount, pageFrame);
 
             m_pageCount++;
 
-            connect(pageView, &AppGridView::requestScrollLeft, this, &MultiPagesView::dragToLeft);
-            connect(pageView, &AppGridView::requestScrollRight, this, &MultiPagesView::dragToRight);
-            connect(pageView, &AppGridView::requestScrollStop, [this] {
-                m_bDragStart = false;
-                setGradientVisible(false);
-            });
-            connect(pageView, &AppGridView::dragEnd, this, &MultiPagesView::dragStop);
-            connect(m_pageSwitchAnimation, &QPropertyAnimation::finished,pageView,&AppGridView::setDragAnimationEnable);
-            connect(m_pageSwitchAnimation, &QPropertyAnimation::finished,this, [ = ] {
-                    setGradientVisible(false);
-            });
-            emit connectViewEvent(pageView);
             // 新增的页面需要设置一下大小
             updatePosition();
         }
     } else {
-        while (pageCount < m_pageCount) {
-            AppGridView *pageView = qobject_cast<AppGridView *>(m_viewBox->layout()->itemAt(m_pageCount - 1)->widget());
-            m_viewBox->layout()->removeWidget(pageView);
-            pageView->model()->deleteLater();
-            pageView->deleteLater();
+        m_pageCount = pageCount;
+        m_pageIndex = qMin(m_pageIndex, m_pageCount - 1);
+
+        // 先将视图从需要删除的页面中移出
+        bindPages();
+
+        while (m_pageFrames.size() > m_pageCount) {
+            QWidget *pageFrame = m_pageFrames.takeLast();
 
-            m_pageAppsModelList.removeLast();
-            m_appGridViewList.removeLast();
+            // 拖拽源视图不能随页面一起删除
+            if (m_dragSourceView && m_dragSourceView->parentWidget() == pageFrame)
+                m_dragSourceView->setParent(m_viewBox);
 
-            m_pageCount--;
+            m_viewBox->layout()->removeWidget(pageFrame);
+            pageFrame->deleteLater();
         }
     }
 
     m_pageControl->setPageCount(m_pageCount > 1 ? pageCount : 0);
 }
 
+/**
+ * @brief MultiPagesView::createPageView 创建一个可复用的分页视图及其模型
+ * @return 分页视图
+ */
+AppGridView *MultiPagesView::createPageView()
+{
+    AppsListModel *pModel = new AppsListModel(m_category, this);
+    m_pageAppsModelList.push_back(pModel);
+
+    AppGridView *pageView = new AppGridView(m_viewBox);
+    pageView->setModel(pModel);
+    pageView->setItemDelegate(m_delegate);
+    pageView->setContainerBox(m_appListArea);
+    pageView->installEventFilter(this);
+    pageView->setDelegate(this);
+    pageView->hide();
+    m_appGridViewList.push_back(pageView);
+
+    connect(pageView, &AppGridView::requestScrollLeft, this, &MultiPagesView::dragToLeft);
+    connect(pageView, &AppGridView::requestScrollRight, this, &MultiPagesView::dragToRight);
+    connect(pageView, &AppGridView::requestScrollStop, [this] {
+        m_bDragStart = false;
+        setGradientVisible(false);
+    });
+    connect(pageView, &AppGridView::dragStarted, this, [this, pageView] { m_dragSourceView = pageView; });
+    connect(pageView, &AppGridView::dragEnd, this, &MultiPagesView::dragStop);
+    connect(m_pageSwitchAnimation, &QPropertyAnimation::finished,pageView,&AppGridView::setDragAnimationEnable);
+    emit connectViewEvent(pageView);
+
+    return pageView;
+}
+
+/**
+ * @brief MultiPagesView::bindPages 将视图绑定到当前页及相邻两页,
+ * 不在范围内的视图重新绑定到新进入范围的页面, 超出页数的视图隐藏备用,
+ * 拖拽源视图在拖拽结束前保持原有的分页和模型, 不参与复用
+ */
+void MultiPagesView::bindPages()
+{
+    const int firstPage = qMax(0, m_pageIndex - 1);
+    const int lastPage = qMin(m_pageCount - 1, m_pageIndex + 1);
+
+    // 找出不在范围内的视图
+    AppGridViewList freeViews;
+    for (AppGridView *pView : m_appGridViewList) {
+        if (pView == m_dragSourceView)
+            continue;
+
+        const int page = m_pageFrames.indexOf(pView->parentWidget());
+        if (page < firstPage || page > lastPage)
+            freeViews << pView;
+    }
+
+    for (int page = firstPage; page <= lastPage; page++) {
+        if (pageView(page))
+            continue;
+
+        AppGridView *pView = freeViews.isEmpty() ? createPageView() : freeViews.takeFirst();
+        AppsListModel *pModel = m_pageAppsModelList[m_appGridViewList.indexOf(pView)];
+        pModel->setPageIndex(page);
+
+        QWidget *pageFrame = m_pageFrames[page];
+        pView->setParent(pageFrame);
+        pView->setFixedSize(pageFrame->size());
+        pView->move(0, 0);
+        pView->show();
+    }
+
+    for (AppGridView *pView : freeViews) {
+        if (pView->parentWidget() == m_viewBox)
+            continue;
+
+        pView->hide();
+        pView->setParent(m_viewBox);
+    }
+}
+
 /**
  * @brief MultiPagesView::dragToLeft 在当前列表页向左拖动item
  * @param index 拖动item对应的模型索引
@@ -201,17 +267,18 @@ void MultiPagesView::dragToLeft(const QModelIndex &index)
     if (isScrolling() || m_bDragStart)
         return;
 
-    m_appGridViewList[m_pageIndex]->dragOut(-1);
+    pageView(m_pageIndex)->dragOut(-1);
 
     showCurrentPage(m_pageIndex - 1);
 
-    int lastApp = m_pageAppsModelList[m_pageIndex]->rowCount(QModelIndex());
-    QModelIndex firstModel = m_appGridViewList[m_pageIndex]->indexAt(lastApp - 1);
-    m_appGridViewList[m_pageIndex]->dragIn(firstModel, m_pageSwitchAnimation->state() != QPropertyAnimation::Running);
+    AppGridView *pView = pageView(m_pageIndex);
+    int lastApp = pageModel(m_pageIndex)->rowCount(QModelIndex());
+    QModelIndex firstModel = pView->indexAt(lastApp - 1);
+    pView->dragIn(firstModel, m_pageSwitchAnimation->state() != QPropertyAnimation::Running);
 
     // 保存向左拖拽后item回归的终点位置
-    const QPoint &dropCursorPoint = m_appGridViewList[m_pageIndex]->appIconRect(firstModel).topLeft();
-    m_appGridViewList[m_pageIndex]->setDropAndLastPos(dropCursorPoint);
+    const QPoint &dropCursorPoint = pView->appIconRect(firstModel).topLeft();
+    pView->setDropAndLastPos(dropCursorPoint);
 
     m_bDragStart = true;
 }
@@ -232,19 +299,20 @@ void MultiPagesView::dragToRight(const QModelIndex &index)
     // 当前页面准备空出最后一个图标
     int newPos = m_calcUtil->appPageItemCount(m_category);
     // 下一页的末尾位置
-    m_appGridViewList[m_pageIndex]->dragOut(newPos * 2 - 1);
+    pageView(m_pageIndex)->dragOut(newPos * 2 - 1);
 
     // 展开下一页
     showCurrentPage(m_pageIndex + 1);
 
     // 将最后一个App'挤走'
-    int lastApp = m_pageAppsModelList[m_pageIndex]->rowCount(QModelIndex());
-    QModelIndex lastModel = m_appGridViewList[m_pageIndex]->indexAt(lastApp - 1);
-    m_appGridViewList[m_pageIndex]->dragIn(lastModel, m_pageSwitchAnimation->state() != QPropertyAnimation::Running);
+    AppGridView *pView = pageView(m_pageIndex);
+    int lastApp = pageModel(m_pageIndex)->rowCount(QModelIndex());
+    QModelIndex lastModel = pView->indexAt(lastApp - 1);
+    pView->dragIn(lastModel, m_pageSwitchAnimation->state() != QPropertyAnimation::Running);
 
     // 保存向右拖拽后item回归的终点位置
-    const QPoint &dropCursorPoint = m_appGridViewList[m_pageIndex]->appIconRect(lastModel).topLeft();
-    m_appGridViewList[m_pageIndex]->setDropAndLastPos(dropCursorPoint);
+    const QPoint &dropCursorPoint = pView->appIconRect(lastModel).topLeft();
+    pView->setDropAndLastPos(dropCursorPoint);
 
     m_bDragStart = true;
 }
@@ -254,10 +322,17 @@ void MultiPagesView::dragToRight(const QModelIndex &index)
  */
 void MultiPagesView::dragStop()
 {
-    if (sender() == m_appGridViewList[m_pageIndex])
+    // 拖拽结束后拖拽源视图重新参与复用, 等拖拽源处理完成后再重新绑定
+    if (sender() == m_dragSourceView) {
+        m_dragSourceView = nullptr;
+        QMetaObject::invokeMethod(this, &MultiPagesView::bindPages, Qt::QueuedConnection);
+    }
+
+    AppGridView *pView = pageView(m_pageIndex);
+    if (!pView || sender() == pView)
         return;
 
-    m_appGridViewList[m_pageIndex]->flashDrag();
+    pView->flashDrag();
 }
 
 /**
@@ -267,7 +342,11 @@ void MultiPagesView::dragStop()
  */
 QModelIndex MultiPagesView::getAppItem(int index)
 {
-    return m_appGridViewList[m_pageIndex]->indexAt(index);
+    AppGridView *pView = pageView(m_pageIndex);
+    if (!pView)
+        return QModelIndex();
+
+    return pView->indexAt(index);
 }
 
 /**
@@ -286,13 +365,18 @@ void MultiPagesView::setDataDelegate(QAbstractItemDelegate *delegate)
 void MultiPagesView::ShowPageView(AppsListModel::AppCategory category)
 {
     int pageCount = m_appsManager->getPageCount(category);
-    for (int i = 0; i < qMax(pageCount, m_pageCount); i++) {
-        m_appGridViewList[i]->setVisible(i < pageCount);
-        m_pageAppsModelList[i]->setCategory(category);
-    }
+    for (int i = 0; i < m_pageFrames.size(); i++)
+        m_pageFrames[i]->setVisible(i < pageCount);
+
+    for (AppsListModel *pModel : m_pageAppsModelList)
+        pModel->setCategory(category);
+
     m_pageControl->setPageCount(pageCount > 1 ? pageCount : 0);
-    m_pageCount = pageCount;
+    m_pageCount = qMin(pageCount, m_pageFrames.size());
     m_category = category;
+    m_pageIndex = qBound(0, m_pageIndex, qMax(0, m_pageCount - 1));
+
+    bindPages();
 }
 
 /**
@@ -301,7 +385,7 @@ void MultiPagesView::ShowPageView(AppsListModel::AppCategory category)
  */
 void MultiPagesView::setModel(AppsListModel::AppCategory category)
 {
-    for (int i = 0; i < m_pageCount; i++) {
+    for (int i = 0; i < m_appGridViewList.size(); i++) {
         m_pageAppsModelList[i]->setCategory(category);
         m_appGridViewList[i]->setModel(m_pageAppsModelList[i]);
     }
@@ -334,6 +418,9 @@ void MultiPagesView::updatePosition(int mode)
         m_appListArea->setFixedSize(size());
         m_viewBox->setFixedHeight(tmpSize.height());
 
+        for (auto pFrame : m_pageFrames)
+            pFrame->setFixedSize(tmpSize);
+
         for (auto pView : m_appGridViewList)
             pView->setFixedSize(tmpSize);
     } else {
@@ -343,6 +430,9 @@ void MultiPagesView::updatePosition(int mode)
         m_appListArea->setFixedSize(tmpSize);
         m_viewBox->setFixedHeight(tmpSize.height());
 
+        for (auto pFrame : m_pageFrames)
+            pFrame->setFixedSize(tmpSize);
+
         for (auto pView : m_appGridViewList)
             pView->setFixedSize(tmpSize);
     }
@@ -373,7 +463,9 @@ void MultiPagesView::showCurrentPage(int currentPage)
         padding = m_calcUtil->getScreenSize().width() * DLauncher::SIDES_SPACE_SCALE / 2;
 
     m_pageIndex = currentPage > 0 ? (currentPage < m_pageCount ? currentPage : m_pageCount - 1) : 0;
-    int endValue = m_pageIndex == 0 ? 0 : (m_appGridViewList[m_pageIndex]->x() - padding);
+    bindPages();
+
+    int endValue = m_pageIndex == 0 ? 0 : (m_pageFrames[m_pageIndex]->x() - padding);
     int startValue = m_appListArea->horizontalScrollBar()->value();
     m_appListArea->setProperty("curPage", m_pageIndex);
 
@@ -397,8 +489,8 @@ QModelIndex MultiPagesView::selectApp(const int key)
             -- page;
             itemSelect = m_calcUtil->appPageItemCount(m_category) - 1;
         } else {
+            // 跳转到尾页的最后一个应用, 尾页视图在翻页后才绑定
             page = m_pageCount - 1;
-            itemSelect = m_pageAppsModelList[page]->rowCount(QModelIndex()) - 1;
         }
     } else {
         if (page + 1 < m_pageCount) {
@@ -412,23 +504,37 @@ QModelIndex MultiPagesView::selectApp(const int key)
     if (page != m_pageIndex)
         showCurrentPage(page);
 
-    return m_appGridViewList[m_pageIndex]->indexAt(itemSelect);
+    if (itemSelect < 0)
+        itemSelect = pageModel(m_pageIndex)->rowCount(QModelIndex()) - 1;
+
+    return pageView(m_pageIndex)->indexAt(itemSelect);
 }
 
+/**
+ * @brief MultiPagesView::pageView 获取绑定到指定分页的视图
+ * @param pageIndex 分页索引
+ * @return 只有当前页及相邻两页有对应的视图, 其余分页返回空指针
+ */
 AppGridView *MultiPagesView::pageView(int pageIndex)
 {
-    if (pageIndex >= m_pageCount)
+    if (pageIndex < 0 || pageIndex >= m_pageCount || pageIndex >= m_pageFrames.size())
         return nullptr;
 
-    return m_appGridViewList[pageIndex];
+    for (AppGridView *pView : m_appGridViewList) {
+        if (pView->parentWidget() == m_pageFrames[pageIndex])
+            return pView;
+    }
+
+    return nullptr;
 }
 
 AppsListModel *MultiPagesView::pageModel(int pageIndex)
 {
-    if (pageIndex >= m_pageCount)
+    AppGridView *pView = pageView(pageIndex);
+    if (!pView)
         return nullptr;
 
-    return m_pageAppsModelList[pageIndex];
+    return m_pageAppsModelList[m_appGridViewList.indexOf(pView)];
 }
 
 void MultiPagesView::wheelEvent(QWheelEvent *e)
@@ -486,7 +592,7 @@ void MultiPagesView::mouseRelease(QMouseEvent *e)
         int nScroll = m_appListArea->horizontalScrollBar()->value();
         // 多个分页是点击直接隐藏
         if (nScroll == m_scrollStart && m_pageCount != 1 && m_category != AppsListModel::Search)
-            emit m_appGridViewList[m_pageIndex]->clicked(QModelIndex());
+            emit pageView(m_pageIndex)->clicked(QModelIndex());
         else if (nScroll - m_scrollStart > DLauncher::MOUSE_MOVE_TO_NEXT)
             showCurrentPage(m_pageIndex + 1);
         else if (nScroll - m_scrollStart < -DLauncher::MOUSE_MOVE_TO_NEXT)
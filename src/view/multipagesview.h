@@ -11,6 +11,7 @@
 #include <QScrollBar>
 #include <QHBoxLayout>
 #include <QPropertyAnimation>
+#include <QPointer>
 
 #include "../widgets/applistarea.h"
 #include "appgridview.h"
@@ -81,6 +82,10 @@ protected:
     void wheelEvent(QWheelEvent *e) Q_DECL_OVERRIDE;
     void InitUI();
 
+private:
+    AppGridView *createPageView();
+    void bindPages();
+
 private:
     GradientLabel *m_pLeftGradient;
     GradientLabel *m_pRightGradient;
@@ -88,8 +93,9 @@ private:
     AppsManager *m_appsManager;                         // 应用管理类
     CalculateUtil *m_calcUtil;                          // 界面布局计算类
     AppListArea *m_appListArea;                         // 滑动区域控件
-    AppGridViewList m_appGridViewList;                  // 多视图列表
-    PageAppsModelist m_pageAppsModelList;               // 多视图模型列表
+    AppGridViewList m_appGridViewList;                  // 复用的视图列表, 只保留当前页及相邻两页
+    PageAppsModelist m_pageAppsModelList;               // 复用的视图模型列表, 与视图一一对应
+    QList<QWidget *> m_pageFrames;                      // 每一页的占位控件, 视图绑定到哪一页就放在哪一页的占位控件中
 
     DHBoxWidget *m_viewBox;
 
@@ -103,6 +109,7 @@ private:
     AppsListModel::AppCategory m_category;
 
     bool m_bDragStart;
+    QPointer<AppGridView> m_dragSourceView;             // 拖拽源视图, 拖拽结束前保持绑定的分页和模型, 不参与复用
 
     bool m_bMousePress;
     int m_nMousePos;
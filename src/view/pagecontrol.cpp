@@ -4,6 +4,7 @@
 
 #include "pagecontrol.h"
 #include "util.h"
+#include "skinassetcache.h"
 #include "appsmanager.h"
 
 #include <QBoxLayout>
@@ -16,8 +17,8 @@ PageControl::PageControl(QWidget *parent)
     layout->setSpacing(PAGE_ICON_SPACE);
     setLayout(layout);
 
-    m_iconActive = loadSvg(":/widgets/images/page_indicator_active.svg", qRound(PAGE_ICON_SIZE * devicePixelRatioF()));
-    m_iconNormal = loadSvg(":/widgets/images/page_indicator.svg", qRound(PAGE_ICON_SIZE * devicePixelRatioF()));
+    m_iconActive = SkinAssetCache::squareSvg(":/widgets/images/page_indicator_active.svg", qRound(PAGE_ICON_SIZE * devicePixelRatioF()));
+    m_iconNormal = SkinAssetCache::squareSvg(":/widgets/images/page_indicator.svg", qRound(PAGE_ICON_SIZE * devicePixelRatioF()));
 
     createButtons();
 }
@@ -5,6 +5,7 @@
 #include "categorybutton.h"
 #include "constants.h"
 #include "util.h"
+#include "skinassetcache.h"
 
 #include <QHBoxLayout>
 #include <QDebug>
@@ -80,7 +81,7 @@ void CategoryButton::setInfoByCategory()
 
 //    const auto ratio = devicePixelRatioF();
     m_systemTheme = "_dark";
-    m_icon = loadSvg(QString(":/icons/skin/icons/category_%1%2.svg").arg(m_iconName, m_systemTheme), qRound(DLauncher::NAVIGATION_ICON_SIZE * devicePixelRatioF()));
+    m_icon = SkinAssetCache::squareSvg(QString(":/icons/skin/icons/category_%1%2.svg").arg(m_iconName, m_systemTheme), qRound(DLauncher::NAVIGATION_ICON_SIZE * devicePixelRatioF()));
     m_icon.setDevicePixelRatio(qApp->devicePixelRatio());
 }
 
@@ -5,6 +5,7 @@
 #include "miniframeswitchbtn.h"
 #include "../windowedframe.h"
 #include "../global_util/util.h"
+#include "../global_util/skinassetcache.h"
 
 #include <QHBoxLayout>
 #include <DGuiApplicationHelper>
@@ -106,13 +107,13 @@ void MiniFrameSwitchBtn::updateIcon()
 {
     if (DGuiApplicationHelper::DarkType == DGuiApplicationHelper::instance()->themeType()) {
         m_color.setRgb(255, 255, 255, 25);
-        m_allIconLabel->setPixmap(renderSVG(":/widgets/images/all.svg", QSize(20, 20)));
-        m_enterIcon->setPixmap(renderSVG(":/widgets/images/enter_details_normal.svg", QSize(16, 16)));
+        m_allIconLabel->setPixmap(SkinAssetCache::svg(":/widgets/images/all.svg", QSize(20, 20)));
+        m_enterIcon->setPixmap(SkinAssetCache::svg(":/widgets/images/enter_details_normal.svg", QSize(16, 16)));
 
     } else {
         m_color.setRgb(0, 0, 0, 25);
-        m_allIconLabel->setPixmap(renderSVG(":/widgets/images/all-dark.svg", QSize(20, 20)));
-        m_enterIcon->setPixmap(renderSVG(":/widgets/images/enter_details_normal-dark.svg", QSize(16, 16)));
+        m_allIconLabel->setPixmap(SkinAssetCache::svg(":/widgets/images/all-dark.svg", QSize(20, 20)));
+        m_enterIcon->setPixmap(SkinAssetCache::svg(":/widgets/images/enter_details_normal-dark.svg", QSize(16, 16)));
     }
 
     QPalette pa = m_textLabel->palette();
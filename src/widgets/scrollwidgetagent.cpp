@@ -23,6 +23,7 @@ ScrollWidgetAgent::ScrollWidgetAgent(QObject *parent)
 
     m_animation->setDuration(DGuiApplicationHelper::isSpecialEffectsEnvironment() ? 200 : 0);
 
+    connect(m_animation, &QPropertyAnimation::stateChanged, this, &ScrollWidgetAgent::animationStateChanged);
     connect(m_animation, &QPropertyAnimation::finished, this, &ScrollWidgetAgent::scrollFinished);
 }
 
@@ -40,10 +41,19 @@ void ScrollWidgetAgent::setBlurBoxWidget(BlurBoxWidget *blurBoxWidget)
 {
     if (m_blurBoxWidget != blurBoxWidget){
         m_blurBoxWidget = blurBoxWidget;
+
+        // 滑动过程中重新绑定了分类控件, 旧控件的截图不能再使用, 下次显示时重新截图
+        if (m_useSnapshot) {
+            m_snapshotTaken = false;
+            m_snapshotLabel->hide();
+            m_snapshotLabel->clear();
+        }
+
         updateBackBlurWidget();
         if (m_blurBoxWidget) {
             m_blurBoxWidget->move(m_pos);
-            updateBackBlurPos();
+            if (!m_useSnapshot)
+                updateBackBlurPos();
         }
     }
 }
@@ -53,13 +63,30 @@ void ScrollWidgetAgent::setPos(QPoint p)
     m_pos = p;
     if (m_blurBoxWidget) {
         m_blurBoxWidget->move(m_pos);
-        updateBackBlurPos();
+
+        // 滑动过程中只移动截图, 不重新计算模糊背景
+        if (m_useSnapshot)
+            m_snapshotLabel->move(m_pos);
+        else
+            updateBackBlurPos();
     }
     emit scrollBlurBoxWidget(this);
 }
 
 void ScrollWidgetAgent::setVisible(bool visible)
 {
+    if (m_useSnapshot) {
+        m_visible = visible;
+        if (visible) {
+            showSnapshot();
+        } else {
+            m_snapshotLabel->hide();
+            if (m_blurBoxWidget)
+                m_blurBoxWidget->setVisible(false);
+        }
+        return;
+    }
+
     if (m_blurBoxWidget) {
         m_blurBoxWidget->setVisible(visible);
         updateBackBlurPos();
@@ -79,6 +106,67 @@ void ScrollWidgetAgent::setScrollToType(PosType posType)
     m_animation->setEndValue(m_scrollPos);
 }
 
+/**
+ * @brief ScrollWidgetAgent::animationStateChanged 滑动开始时将分类控件替换为静态截图,
+ * 滑动过程中每帧只需绘制一张图片, 不再重复计算模糊背景和重绘列表; 滑动结束后恢复分类控件
+ * @param newState 动画状态
+ */
+void ScrollWidgetAgent::animationStateChanged(QAbstractAnimation::State newState)
+{
+    if (newState == QAbstractAnimation::Running) {
+        if (!m_controlWidget || m_animation->duration() <= 0)
+            return;
+
+        if (!m_snapshotLabel) {
+            m_snapshotLabel = new QLabel(m_controlWidget);
+            m_snapshotLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+            m_snapshotLabel->hide();
+        }
+
+        m_visible = m_blurBoxWidget && m_blurBoxWidget->isVisible();
+        m_useSnapshot = true;
+        m_snapshotTaken = false;
+        if (m_visible)
+            showSnapshot();
+    } else if (newState == QAbstractAnimation::Stopped && m_useSnapshot) {
+        m_useSnapshot = false;
+        m_snapshotTaken = false;
+        m_snapshotLabel->hide();
+        m_snapshotLabel->clear();
+
+        if (m_blurBoxWidget) {
+            m_blurBoxWidget->move(m_pos);
+            m_blurBoxWidget->setVisible(m_visible);
+            updateBackBlurPos();
+        }
+    }
+}
+
+/**
+ * @brief ScrollWidgetAgent::showSnapshot 显示分类控件的截图, 每次滑动只截取一次,
+ * 之后只移动截图位置
+ */
+void ScrollWidgetAgent::showSnapshot()
+{
+    if (!m_useSnapshot || !m_blurBoxWidget)
+        return;
+
+    if (!m_snapshotTaken) {
+        // 控件显示时才会完成布局, 截图前确保已经显示
+        if (!m_blurBoxWidget->isVisible())
+            m_blurBoxWidget->setVisible(true);
+
+        m_snapshotLabel->setPixmap(m_blurBoxWidget->grab());
+        m_snapshotLabel->resize(m_blurBoxWidget->size());
+        m_snapshotTaken = true;
+    }
+
+    m_blurBoxWidget->setVisible(false);
+    m_snapshotLabel->move(m_pos);
+    m_snapshotLabel->setVisible(m_visible);
+    m_snapshotLabel->raise();
+}
+
 void ScrollWidgetAgent::scrollFinished()
 {
     m_currentPosType = m_scrollToType;
@@ -113,7 +201,9 @@ void ScrollWidgetAgent::updateBackBlurWidget()
         default: break;
         }
 
-        m_blurBoxWidget->update();
+        // 滑动过程中沿用滑动开始时的截图, 滑动结束恢复分类控件后再按新的遮罩状态绘制
+        if (!m_useSnapshot)
+            m_blurBoxWidget->update();
     }
 }
 
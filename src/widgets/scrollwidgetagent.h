@@ -6,6 +6,7 @@
 #define SCROLLWIDGETAGENT_H
 
 #include <QObject>
+#include <QLabel>
 
 #include "blurboxwidget.h"
 #include "../global_util/calculate_util.h"
@@ -72,6 +73,10 @@ protected:
     void updateBackBlurWidget();
     void updateBackBlurPos();
 
+private:
+    void animationStateChanged(QAbstractAnimation::State newState);
+    void showSnapshot();
+
 private:
     QPoint m_pos;
     QPoint m_scrollPos;
@@ -81,6 +86,10 @@ private:
     QPropertyAnimation *m_animation;
     PosType m_currentPosType;
     PosType m_scrollToType;
+    QLabel *m_snapshotLabel = nullptr;                  // 滑动过程中代替分类控件显示的静态截图
+    bool m_useSnapshot = false;                         // 是否处于截图滑动状态
+    bool m_snapshotTaken = false;                       // 本次滑动是否已截图
+    bool m_visible = false;                             // 截图滑动状态下分类控件应有的显示状态
 };
 
 #endif // SCROLLWIDGETAGENT_H
@@ -8,6 +8,7 @@
 #include "dbusdockinterface.h"
 #include "constants.h"
 #include "iconcachemanager.h"
+#include "skinassetcache.h"
 
 #include <DWindowManagerHelper>
 #include <DForeignWindow>
@@ -528,7 +529,9 @@ void WindowedFrame::launchCurrentApp()
 
 void WindowedFrame::uninstallApp(const QString &appKey)
 {
-    uninstallApp(m_appsModel->indexAt(appKey));
+    const QModelIndex index = m_appsModel->indexAt(appKey);
+    if (index.isValid())
+        uninstallApp(index);
 }
 
 void WindowedFrame::uninstallApp(const QModelIndex &context)
@@ -558,8 +561,7 @@ void WindowedFrame::uninstallApp(const QModelIndex &context)
 
     // 命令行安装应用后，卸载应用的确认弹框偶现左上角图标呈齿轮的情况
     QPixmap appIcon;
-    if (IconCacheManager::existInCache(tmpKey)) {
-        IconCacheManager::getPixFromCache(tmpKey, appIcon);
+    if (IconCacheManager::tryGet(tmpKey, appIcon)) {
         unInstallDialog.setIcon(appIcon);
     } else {
         static int tryNum = 0;
@@ -569,8 +571,7 @@ void WindowedFrame::uninstallApp(const QModelIndex &context)
             QTimer::singleShot(100, this, [ = ]() { uninstallApp(context); });
             return;
         } else {
-            QIcon icon = QIcon(":/widgets/images/application-x-desktop.svg");
-            appIcon = icon.pixmap(QSize(size, size));
+            appIcon = SkinAssetCache::fallbackAppIcon(size);
             unInstallDialog.setIcon(appIcon);
         }
     }
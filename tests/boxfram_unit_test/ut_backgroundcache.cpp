@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "backgroundcache.h"
+
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+class Tst_BackgroundCache : public testing::Test
+{
+public:
+    void TearDown() override
+    {
+        BackgroundCache::clear();
+    }
+};
+
+TEST_F(Tst_BackgroundCache, image_test)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    const QString path = dir.filePath("background.png");
+    QImage source(64, 32, QImage::Format_RGB32);
+    source.fill(Qt::blue);
+    ASSERT_TRUE(source.save(path));
+
+    // 源文件不存在时不缓存
+    EXPECT_TRUE(BackgroundCache::key(dir.filePath("none.png"), "scaled").isEmpty());
+
+    const QString key = BackgroundCache::key(path, "scaled", QRect(0, 0, 64, 32), 1.0);
+    EXPECT_NE(key, BackgroundCache::key(path, "scaled", QRect(0, 0, 64, 32), 2.0));
+    EXPECT_TRUE(BackgroundCache::image(key).isNull());
+
+    BackgroundCache::insertImage(key, source);
+    const QImage image = BackgroundCache::image(key);
+    EXPECT_EQ(image.size(), source.size());
+    EXPECT_EQ(image.pixel(10, 10), source.pixel(10, 10));
+
+    BackgroundCache::insertProcessedFile(key, path);
+    EXPECT_EQ(BackgroundCache::processedFile(key), path);
+}
+
+TEST_F(Tst_BackgroundCache, evict_test)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    const QString path = dir.filePath("background.png");
+    QImage source(64, 32, QImage::Format_RGB32);
+    source.fill(Qt::blue);
+    ASSERT_TRUE(source.save(path));
+
+    // 4K 屏幕下的缩放图片, 超出总大小时淘汰最久未使用的条目
+    QImage image(3840, 2160, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+
+    const QString first = BackgroundCache::key(path, "scaled", QRect(0, 0, 3840, 2160), 1.0);
+    const QString second = BackgroundCache::key(path, "scaled", QRect(0, 0, 3840, 2160), 1.5);
+    const QString third = BackgroundCache::key(path, "scaled", QRect(0, 0, 3840, 2160), 2.0);
+    BackgroundCache::insertImage(first, image);
+    BackgroundCache::insertImage(second, image);
+    BackgroundCache::insertImage(third, image);
+
+    EXPECT_TRUE(BackgroundCache::image(first).isNull());
+    EXPECT_FALSE(BackgroundCache::image(second).isNull());
+    EXPECT_FALSE(BackgroundCache::image(third).isNull());
+}
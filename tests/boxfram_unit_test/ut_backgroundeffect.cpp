@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "backgroundcache.h"
+#include "backgroundeffect.h"
+
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+class Tst_BackgroundEffect : public testing::Test
+{
+public:
+    void TearDown() override
+    {
+        BackgroundCache::clear();
+    }
+};
+
+TEST_F(Tst_BackgroundEffect, blur_test)
+{
+    // 纯色图片模糊后颜色不变
+    QImage image(40, 20, QImage::Format_RGB32);
+    image.fill(QColor(100, 150, 200));
+    QImage blurred = BackgroundEffect::blur(image, 4);
+    EXPECT_EQ(blurred.size(), image.size());
+    EXPECT_EQ(blurred.pixelColor(20, 10), QColor(100, 150, 200));
+
+    // 黑白分界处模糊后出现过渡色
+    image.fill(Qt::black);
+    for (int y = 0; y < image.height(); ++y)
+        for (int x = image.width() / 2; x < image.width(); ++x)
+            image.setPixel(x, y, qRgb(255, 255, 255));
+
+    blurred = BackgroundEffect::blur(image, 4);
+    const int gray = qGray(blurred.pixel(image.width() / 2, 10));
+    EXPECT_GT(gray, 0);
+    EXPECT_LT(gray, 255);
+}
+
+TEST_F(Tst_BackgroundEffect, pixmix_test)
+{
+    QImage image(8, 8, QImage::Format_RGB32);
+    image.fill(Qt::white);
+    EXPECT_LT(qGray(BackgroundEffect::pixmix(image).pixel(4, 4)), 255);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("background.png");
+    ASSERT_TRUE(image.save(path));
+
+    // 本地处理的结果保存在缓存目录中
+    const QString blurFile = BackgroundEffect::blurFile(path);
+    EXPECT_NE(blurFile, path);
+    EXPECT_TRUE(BackgroundCache::isCachedFile(blurFile));
+    EXPECT_EQ(BackgroundEffect::blurFile(path), blurFile);
+}
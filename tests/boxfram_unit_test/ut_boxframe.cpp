@@ -6,6 +6,9 @@
 #include "boxframe.h"
 #undef private
 
+#include <QFile>
+#include <QTemporaryDir>
+
 #include <gtest/gtest.h>
 
 class Tst_Boxframe : public testing::Test
@@ -21,3 +24,51 @@ TEST_F(Tst_Boxframe, checkBackground_test)
     frame.m_lastUrl.clear();
     frame.m_lastBlurUrl.clear();
 }
+
+TEST_F(Tst_Boxframe, loadScaledImage_test)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    const QString path = dir.filePath("background.png");
+    QImage image(400, 200, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    ASSERT_TRUE(image.save(path));
+
+    // 按比例扩展填满目标尺寸
+    EXPECT_EQ(BoxFrame::loadScaledImage(path, QString(), QSize(100, 100)).size(), QSize(200, 100));
+
+    bool usedFallback = true;
+    BoxFrame::loadScaledImage(path, QString(), QSize(100, 100), &usedFallback);
+    EXPECT_FALSE(usedFallback);
+
+    // 图片无法读取时使用备用图片
+    EXPECT_EQ(BoxFrame::loadScaledImage(dir.filePath("none.png"), path, QSize(100, 50)).size(), QSize(100, 50));
+
+    // 图片存在但无法解码时同样使用备用图片
+    const QString brokenPath = dir.filePath("broken.png");
+    QFile broken(brokenPath);
+    ASSERT_TRUE(broken.open(QIODevice::WriteOnly));
+    broken.write("not an image");
+    broken.close();
+
+    usedFallback = false;
+    EXPECT_EQ(BoxFrame::loadScaledImage(brokenPath, path, QSize(100, 50), &usedFallback).size(), QSize(100, 50));
+    EXPECT_TRUE(usedFallback);
+}
+
+TEST_F(Tst_Boxframe, failedLoad_test)
+{
+    BoxFrame frame;
+    frame.m_defaultBg = "/dde-launcher-none/default.png";
+
+    // 解码失败后清除键值, 同一图片再次请求时重新加载
+    const QString url("/dde-launcher-none/background.png");
+    EXPECT_TRUE(frame.requestScaledImage(frame.m_backgroundWatcher, frame.m_backgroundKey, url));
+    frame.m_backgroundWatcher->waitForFinished();
+    frame.onBackgroundLoaded();
+    EXPECT_TRUE(frame.m_backgroundKey.isEmpty());
+
+    EXPECT_TRUE(frame.requestScaledImage(frame.m_backgroundWatcher, frame.m_backgroundKey, url));
+    frame.m_backgroundWatcher->waitForFinished();
+}
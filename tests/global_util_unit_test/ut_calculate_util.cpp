@@ -94,3 +94,53 @@ TEST_F(Tst_calculate, appIconSize_test)
     QVERIFY(CalculateUtil::instance()->decreaseIconSize());
 }
 
+
+TEST_F(Tst_calculate, metrics_test)
+{
+    CalculateUtil *calcUtil = CalculateUtil::instance();
+    const LayoutMetrics metrics = calcUtil->metrics();
+
+    // 快照中的值与各接口返回值一致
+    QCOMPARE(calcUtil->getScreenSize(), metrics.screenSize);
+    QCOMPARE(calcUtil->getAppBoxSize(), QSize(int(metrics.screenSize.width() * 0.51), int(metrics.screenSize.height() * 0.69)));
+    QCOMPARE(calcUtil->calculateIconSize(ALL_APPS), metrics.iconSizes[ALL_APPS]);
+    QCOMPARE(calcUtil->calculateIconSize(GROUP_BY_CATEGORY), metrics.iconSizes[GROUP_BY_CATEGORY]);
+
+    // 布局计算只替换快照, 屏幕相关参数不变
+    calcUtil->calculateAppLayout(QSize(1200, 800), SEARCH);
+    QCOMPARE(calcUtil->appColumnCount(), metrics.gridColumns[ALL_APPS]);
+    QCOMPARE(calcUtil->getScreenSize(), metrics.screenSize);
+    QCOMPARE(calcUtil->metrics().appItemSize, calcUtil->appItemSize().width());
+
+    // 调整应用项大小同样更新快照
+    const int itemSize = calcUtil->metrics().appItemSize;
+    calcUtil->increaseItemSize();
+    QCOMPARE(calcUtil->metrics().appItemSize, itemSize + 16);
+    calcUtil->decreaseItemSize();
+    QCOMPARE(calcUtil->metrics().appItemSize, itemSize);
+}
+
+TEST_F(Tst_calculate, gridDensity_test)
+{
+    CalculateUtil *calcUtil = CalculateUtil::instance();
+    const CalculateUtil::GridDensity density = calcUtil->gridDensity();
+
+    // 固定布局与原有的7x4和4x3布局一致
+    calcUtil->setGridDensity(CalculateUtil::FixedGrid);
+    QCOMPARE(calcUtil->appPageItemCount(AppsListModel::All), 28);
+    QCOMPARE(calcUtil->appPageItemCount(AppsListModel::Internet), 12);
+
+    // 按屏幕选取的行列数不少于固定布局, 且更紧凑的密度不会减少每页数量
+    calcUtil->setGridDensity(CalculateUtil::StandardGrid);
+    const int standardCount = calcUtil->appPageItemCount(AppsListModel::All);
+    QVERIFY(standardCount >= 28);
+    QVERIFY(calcUtil->appPageItemCount(AppsListModel::Internet) >= 12);
+
+    calcUtil->setGridDensity(CalculateUtil::CompactGrid);
+    QVERIFY(calcUtil->appPageItemCount(AppsListModel::All) >= standardCount);
+
+    QCOMPARE(calcUtil->chooseGrid(QSize(100, 100), ALL_APPS), QSize(7, 4));
+    QCOMPARE(calcUtil->chooseGrid(QSize(10000, 10000), GROUP_BY_CATEGORY), QSize(6, 5));
+
+    calcUtil->setGridDensity(density);
+}
@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define private public
+#include "dayrolloverscheduler.h"
+#undef private
+
+#include <QSignalSpy>
+
+#include <gtest/gtest.h>
+
+class Tst_DayRolloverScheduler : public testing::Test
+{};
+
+TEST_F(Tst_DayRolloverScheduler, reschedule_test)
+{
+    DayRolloverScheduler *scheduler = DayRolloverScheduler::instance();
+    EXPECT_EQ(scheduler, DayRolloverScheduler::instance());
+    EXPECT_EQ(scheduler->currentDate(), QDate::currentDate());
+
+    QSignalSpy spy(scheduler, &DayRolloverScheduler::dayChanged);
+
+    // 日期未变化时只重新设置定时器
+    scheduler->reschedule();
+    EXPECT_EQ(spy.count(), 0);
+
+    // 模拟跨过零点
+    scheduler->m_date = QDate::currentDate().addDays(-1);
+    scheduler->reschedule();
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_EQ(spy.first().first().toDate(), QDate::currentDate());
+    EXPECT_EQ(scheduler->currentDate(), QDate::currentDate());
+}
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "displaytopology.h"
+
+#include <QGuiApplication>
+
+#include <gtest/gtest.h>
+
+class Tst_DisplayTopology : public testing::Test
+{};
+
+TEST_F(Tst_DisplayTopology, screens_test)
+{
+    DisplayTopology *topology = DisplayTopology::instance();
+    EXPECT_EQ(topology, DisplayTopology::instance());
+
+    // 屏幕信息与 QGuiApplication 一致
+    EXPECT_EQ(topology->screens(), qApp->screens());
+    EXPECT_EQ(topology->primaryScreen(), qApp->primaryScreen());
+    ASSERT_TRUE(topology->currentScreen());
+
+    QScreen *primary = topology->primaryScreen();
+    EXPECT_EQ(topology->screenAt(primary->geometry().center()), primary);
+
+    // 任务栏位置直接返回缓存值, 与 D-Bus 属性一致
+    DBusDock dockInter;
+    EXPECT_EQ(topology->dockPosition(), dockInter.position());
+}
@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "idlemode.h"
+
+#include <QSignalSpy>
+
+#include <gtest/gtest.h>
+
+class Tst_IdleMode : public testing::Test
+{};
+
+TEST_F(Tst_IdleMode, enter_leave_test)
+{
+    IdleMode *idleMode = IdleMode::instance();
+    EXPECT_EQ(idleMode, IdleMode::instance());
+
+    const bool idle = idleMode->isIdle();
+    idleMode->leave();
+
+    QSignalSpy spy(idleMode, &IdleMode::idleChanged);
+
+    // 状态未变化时不重复通知
+    idleMode->enter();
+    idleMode->enter();
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_TRUE(spy.takeFirst().first().toBool());
+    EXPECT_TRUE(idleMode->isIdle());
+
+    idleMode->leave();
+    idleMode->leave();
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_FALSE(spy.takeFirst().first().toBool());
+    EXPECT_FALSE(idleMode->isIdle());
+
+    if (idle)
+        idleMode->enter();
+}
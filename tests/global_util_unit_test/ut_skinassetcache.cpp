@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "skinassetcache.h"
+
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_SkinAssetCache : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        SkinAssetCache::clear();
+    }
+};
+
+TEST_F(Tst_SkinAssetCache, sharedPixmap_test)
+{
+    const QPixmap first = SkinAssetCache::svg(":/widgets/images/drag_indicator.svg", QSize(20, 20));
+    const QPixmap second = SkinAssetCache::svg(":/widgets/images/drag_indicator.svg", QSize(20, 20));
+
+    // 相同参数命中缓存，返回共享的图片数据
+    QVERIFY(!first.isNull());
+    QCOMPARE(first.cacheKey(), second.cacheKey());
+    QCOMPARE(SkinAssetCache::count(), 1);
+
+    // 尺寸不同时单独缓存
+    SkinAssetCache::svg(":/widgets/images/drag_indicator.svg", QSize(16, 16));
+    QCOMPARE(SkinAssetCache::count(), 2);
+}
+
+TEST_F(Tst_SkinAssetCache, invalidPath_test)
+{
+    // 不存在的资源不进入缓存
+    QVERIFY(SkinAssetCache::svg("", QSize(20, 20)).isNull());
+    QCOMPARE(SkinAssetCache::count(), 0);
+}
+
+TEST_F(Tst_SkinAssetCache, fallbackAppIcon_test)
+{
+    const QPixmap pixmap = SkinAssetCache::fallbackAppIcon(32);
+    QVERIFY(!pixmap.isNull());
+    QCOMPARE(pixmap.cacheKey(), SkinAssetCache::fallbackAppIcon(32).cacheKey());
+}
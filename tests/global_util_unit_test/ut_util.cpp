@@ -5,6 +5,7 @@
 #include "util.h"
 
 #include <QSize>
+#include <QApplication>
 #include <QTest>
 
 #include <gtest/gtest.h>
@@ -31,3 +32,39 @@ TEST_F(Tst_Util, settingsPtr_test)
 {
     QVERIFY(ModuleSettingsPtr("", "", nullptr) == nullptr);
 }
+
+TEST_F(Tst_Util, mipChain_test)
+{
+    QImage image(64, 64, QImage::Format_ARGB32_Premultiplied);
+    image.fill(qRgba(200, 100, 50, 255));
+
+    // 2x2 box滤波后尺寸减半，纯色图片颜色保持不变
+    const QImage half = boxDownsample(image);
+    QCOMPARE(half.size(), QSize(32, 32));
+    QCOMPARE(half.pixel(10, 10), image.pixel(10, 10));
+
+    QImage level = image;
+    const QPixmap pixmap = mipScaledPixmap(level, 16);
+    QCOMPARE(pixmap.size(), QSize(16, 16) * qApp->devicePixelRatio());
+    QVERIFY(level.width() >= pixmap.width());
+    QVERIFY(level.width() < image.width());
+}
+
+TEST_F(Tst_Util, cacheKey_test)
+{
+    ItemInfo first;
+    first.m_name = "first";
+    first.m_iconKey = "deepin-wine";
+
+    ItemInfo second;
+    second.m_name = "second";
+    second.m_iconKey = "deepin-wine";
+
+    // 使用同一图标的应用共享同一缓存键值，与应用名称无关
+    QCOMPARE(cacheKey(first), cacheKey(second));
+
+    second.m_iconKey = "deepin-terminal";
+    QVERIFY(cacheKey(first) != cacheKey(second));
+
+    resetCacheKeys();
+}
@@ -6,6 +6,7 @@
 
 #include <QApplication>
 #include <QDebug>
+#include <QStandardPaths>
 
 #ifdef SANITIZER_CHECK
 #include <sanitizer/asan_interface.h>
@@ -21,6 +22,9 @@ int main(int argc, char **argv)
     qputenv("QT_QPA_PLATFORM", "offscreen");
     QApplication app(argc,argv);
 
+    // 缓存、配置等目录指向测试目录, 用例中清理缓存时不影响用户的真实数据
+    QStandardPaths::setTestModeEnabled(true);
+
     DLogManager::registerConsoleAppender();
     DLogManager::registerFileAppender();
 
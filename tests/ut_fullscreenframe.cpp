@@ -10,6 +10,8 @@
 #undef private
 
 #include <QTest>
+#include <QApplication>
+#include <QShowEvent>
 
 #include <gtest/gtest.h>
 
@@ -30,3 +32,62 @@ public:
 public:
     FullScreenFrame *m_fullScreenFrame;
 };
+
+TEST_F(Tst_Fullscreenframe, lazyCategoryBox_test)
+{
+    // 启动时不创建分类控件
+    EXPECT_TRUE(m_fullScreenFrame->m_categoryBoxWidgets.isEmpty());
+
+    BlurBoxWidget *boxWidget = m_fullScreenFrame->getCategoryBoxWidget(AppsListModel::Chat);
+    ASSERT_TRUE(boxWidget);
+    EXPECT_EQ(boxWidget->category(), AppsListModel::Chat);
+    EXPECT_EQ(m_fullScreenFrame->getCategoryBoxWidget(AppsListModel::Chat), boxWidget);
+    EXPECT_EQ(m_fullScreenFrame->m_categoryBoxWidgets.size(), 1);
+}
+
+TEST_F(Tst_Fullscreenframe, hideSnapshot_test)
+{
+    // 未截取快照时不可用
+    EXPECT_FALSE(m_fullScreenFrame->isHideSnapshotValid());
+
+    m_fullScreenFrame->captureHideSnapshot();
+    EXPECT_FALSE(m_fullScreenFrame->m_hideSnapshot.pixmap.isNull());
+    EXPECT_EQ(m_fullScreenFrame->isHideSnapshotValid(), m_fullScreenFrame->m_appsManager->isVaild());
+
+    // 背景变化后快照失效
+    emit m_fullScreenFrame->backgroundImageChanged(QPixmap());
+    EXPECT_FALSE(m_fullScreenFrame->isHideSnapshotValid());
+
+    m_fullScreenFrame->releaseHideSnapshot();
+    EXPECT_TRUE(m_fullScreenFrame->m_hideSnapshot.pixmap.isNull());
+    EXPECT_FALSE(m_fullScreenFrame->m_snapshotLabel->isVisible());
+}
+
+TEST_F(Tst_Fullscreenframe, hideSnapshotShowWork_test)
+{
+    m_fullScreenFrame->captureHideSnapshot();
+
+    // 快照不透明, 覆盖时完全遮挡下方界面
+    EXPECT_FALSE(m_fullScreenFrame->m_hideSnapshot.pixmap.hasAlphaChannel());
+    EXPECT_TRUE(m_fullScreenFrame->m_snapshotLabel->testAttribute(Qt::WA_OpaquePaintEvent));
+
+    // 有快照覆盖时, 显示时的耗时操作推迟到快照呈现之后
+    m_fullScreenFrame->showHideSnapshot();
+    QShowEvent showEvent;
+    QApplication::sendEvent(m_fullScreenFrame, &showEvent);
+    EXPECT_TRUE(m_fullScreenFrame->m_showWorkPending);
+
+    m_fullScreenFrame->finishHideSnapshot();
+    EXPECT_FALSE(m_fullScreenFrame->m_showWorkPending);
+    EXPECT_TRUE(m_fullScreenFrame->m_snapshotLabel->isHidden());
+    EXPECT_TRUE(m_fullScreenFrame->m_hideSnapshot.pixmap.isNull());
+
+    // 无快照时显示时直接处理
+    QApplication::sendEvent(m_fullScreenFrame, &showEvent);
+    EXPECT_FALSE(m_fullScreenFrame->m_showWorkPending);
+
+    // 应用布局变化后快照失效
+    m_fullScreenFrame->captureHideSnapshot();
+    emit m_fullScreenFrame->m_calcUtil->layoutChanged();
+    EXPECT_FALSE(m_fullScreenFrame->isHideSnapshotValid());
+}
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "iconcachemanager.h"
+
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_IconCacheManager : public testing::Test
+{
+public:
+    void TearDown() override
+    {
+        IconCacheManager::resetIconData();
+    }
+};
+
+TEST_F(Tst_IconCacheManager, tryGet_test)
+{
+    const QPair<QString, int> key { "ut-icon-cache", 32 };
+    QPixmap pix;
+
+    // 未命中时不会插入空的缓存项
+    QVERIFY(!IconCacheManager::tryGet(key, pix));
+    QVERIFY(!IconCacheManager::existInCache(key));
+    QVERIFY(pix.isNull());
+
+    QPixmap source(32, 32);
+    source.fill(Qt::red);
+    IconCacheManager::insertCache(key, source);
+
+    QVERIFY(IconCacheManager::existInCache(key));
+    QVERIFY(IconCacheManager::tryGet(key, pix));
+    QCOMPARE(pix.cacheKey(), source.cacheKey());
+
+    // 已有有效缓存时不会被覆盖
+    QPixmap other(32, 32);
+    other.fill(Qt::blue);
+    IconCacheManager::insertCache(key, other);
+    QVERIFY(IconCacheManager::tryGet(key, pix));
+    QCOMPARE(pix.cacheKey(), source.cacheKey());
+
+    IconCacheManager::resetIconData();
+    QVERIFY(!IconCacheManager::tryGet(key, pix));
+}
@@ -5,6 +5,7 @@
 #include "applistdelegate.h"
 
 #define private public
+#include "appsmanager.h"
 #include "appgridview.h"
 #include "fullscreenframe.h"
 #undef private
@@ -112,6 +113,49 @@ TEST_F(Tst_Appgridview, listModel_test)
     }
 }
 
+TEST_F(Tst_Appgridview, indexAt_test)
+{
+    AppsListModel *appsListModel = static_cast<AppsListModel *>(m_widget->model());
+    if (!appsListModel)
+        return;
+
+    // 应用key索引与逐行读取的结果一致
+    for (int row = 0; row < appsListModel->rowCount(QModelIndex()); row++) {
+        const QModelIndex index = appsListModel->index(row);
+        EXPECT_EQ(appsListModel->indexAt(index.data(AppsListModel::AppKeyRole).toString()), index);
+    }
+
+    // 不在当前页面的应用返回无效索引
+    EXPECT_FALSE(appsListModel->indexAt("dde-launcher-invalid-app-key").isValid());
+
+    // 其他分类的数据变化通知后, 索引重建后的结果仍与逐行读取的结果一致
+    emit AppsManager::instance()->dataChanged(AppsListModel::Search);
+    for (int row = 0; row < appsListModel->rowCount(QModelIndex()); row++) {
+        const QModelIndex index = appsListModel->index(row);
+        EXPECT_EQ(appsListModel->indexAt(index.data(AppsListModel::AppKeyRole).toString()), index);
+    }
+}
+
+TEST_F(Tst_Appgridview, markLaunched_test)
+{
+    AppsListModel *appsListModel = static_cast<AppsListModel *>(m_widget->model());
+    if (!appsListModel || !appsListModel->rowCount(QModelIndex()))
+        return;
+
+    AppsManager *appsManager = AppsManager::instance();
+    const QModelIndex index = appsListModel->index(0);
+    const QString appKey = index.data(AppsListModel::AppKeyRole).toString();
+
+    // 新安装的应用在绘制快照中带有新安装标识
+    appsManager->m_newInstalledAppsList.append(appKey);
+    appsListModel->invalidateRenderSnapshots();
+    EXPECT_TRUE(index.data(AppsListModel::AppRenderSnapshotRole).value<AppRenderSnapshot>().newInstall);
+
+    // 启动后快照失效, 新安装标识随之清除
+    appsManager->markLaunched(appKey);
+    EXPECT_FALSE(index.data(AppsListModel::AppRenderSnapshotRole).value<AppRenderSnapshot>().newInstall);
+}
+
 TEST_F(Tst_Appgridview, itemDelegate_test)
 {
     AppItemDelegate delegate(m_widget);
@@ -121,3 +165,55 @@ TEST_F(Tst_Appgridview, itemDelegate_test)
     QRect boundRect(QPoint(10, 10), QSize(20, 20));
     delegate.itemTextRect(boundRect, boundRect, true);
 }
+
+TEST_F(Tst_Appgridview, itemLayoutKey_test)
+{
+    AppItemDelegate delegate(m_widget);
+
+    // 设备像素比不同的布局不共用缓存
+    AppItemDelegate::LayoutKey key;
+    key.name = "dde-launcher";
+    key.itemSize = QSize(120, 120);
+    key.iconSize = QSize(64, 64);
+    key.fontKey = m_widget->font().key();
+    key.fontPixelSize = 14;
+    key.drawBlueDot = false;
+    key.ratio = 1.0;
+
+    AppItemDelegate::LayoutKey otherKey = key;
+    EXPECT_TRUE(key == otherKey);
+    otherKey.ratio = 2.0;
+    EXPECT_FALSE(key == otherKey);
+
+    AppsListModel *appsListModel = static_cast<AppsListModel *>(m_widget->model());
+    if (!appsListModel || !appsListModel->rowCount(QModelIndex()))
+        return;
+
+    // 视图命中检测与绘制使用同一份字体和布局
+    m_widget->setItemDelegate(&delegate);
+    const QModelIndex index = appsListModel->index(0);
+    QStyleOptionViewItem option;
+    option.font = m_widget->font();
+    option.rect = m_widget->indexRect(index);
+    EXPECT_EQ(m_widget->appIconRect(index), delegate.itemLayout(option, index).iconRect.translated(option.rect.topLeft()));
+
+    // 字体不同时布局单独缓存
+    const int cacheSize = delegate.m_layoutCache.size();
+    option.font.setPointSize(option.font.pointSize() + 4);
+    delegate.itemLayout(option, index);
+    EXPECT_EQ(delegate.m_layoutCache.size(), cacheSize + 1);
+
+    m_widget->setItemDelegate(nullptr);
+}
+
+TEST_F(Tst_Appgridview, reorderAnimation_test)
+{
+    // 没有需要移动的item时不启动交换动画
+    m_widget->startReorderAnimation();
+    EXPECT_FALSE(m_widget->isReordering());
+
+    m_widget->m_clearDraggingAfterReorder = true;
+    m_widget->reorderFinished();
+    EXPECT_FALSE(m_widget->m_clearDraggingAfterReorder);
+    EXPECT_TRUE(m_widget->m_reorderItems.isEmpty());
+}
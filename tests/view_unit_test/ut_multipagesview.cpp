@@ -2,8 +2,67 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#define private public
+#include "multipagesview.h"
+#undef private
+
+#include <QApplication>
+
 #include <gtest/gtest.h>
 
 class Tst_Multipagesview : public testing::Test
 {
 };
+
+TEST_F(Tst_Multipagesview, pageRecycle_test)
+{
+    MultiPagesView view(AppsListModel::All);
+    view.updatePageCount(AppsListModel::All);
+
+    // 只保留当前页及相邻两页的视图
+    ASSERT_GE(view.pageCount(), 1);
+    EXPECT_LE(view.getAppGridViewList().size(), 3);
+    EXPECT_TRUE(view.pageView(view.currentPage()));
+    EXPECT_TRUE(view.pageModel(view.currentPage()));
+    EXPECT_EQ(view.pageModel(view.currentPage())->pageIndex(), view.currentPage());
+
+    view.showCurrentPage(view.pageCount() - 1);
+    EXPECT_LE(view.getAppGridViewList().size(), 3);
+    EXPECT_TRUE(view.pageView(view.pageCount() - 1));
+    EXPECT_FALSE(view.pageView(view.pageCount()));
+}
+
+TEST_F(Tst_Multipagesview, dragAcrossPages_test)
+{
+    MultiPagesView view(AppsListModel::All);
+    view.updatePageCount(AppsListModel::All);
+
+    // 补足分页, 保证拖拽可以跨越两页以上
+    while (view.m_pageCount < 5) {
+        QWidget *pageFrame = new QWidget;
+        view.m_pageFrames.push_back(pageFrame);
+        view.m_viewBox->layout()->insertWidget(view.m_pageCount, pageFrame);
+        view.m_pageCount++;
+    }
+
+    view.showCurrentPage(0);
+    AppGridView *sourceView = view.pageView(0);
+    ASSERT_TRUE(sourceView);
+    AppsListModel *sourceModel = view.pageModel(0);
+
+    // 拖拽过程中跨越多页, 拖拽源视图仍绑定在原来的分页和模型上
+    emit sourceView->dragStarted();
+    view.showCurrentPage(3);
+    EXPECT_EQ(view.pageView(0), sourceView);
+    EXPECT_EQ(view.pageModel(0), sourceModel);
+    EXPECT_EQ(sourceModel->pageIndex(), 0);
+    EXPECT_TRUE(view.pageView(3));
+    EXPECT_NE(view.pageView(3), sourceView);
+
+    // 拖拽结束后拖拽源视图重新参与复用
+    emit sourceView->dragEnd();
+    QApplication::processEvents();
+    EXPECT_FALSE(view.m_dragSourceView);
+    EXPECT_FALSE(view.pageView(0));
+    EXPECT_TRUE(view.pageView(3));
+}
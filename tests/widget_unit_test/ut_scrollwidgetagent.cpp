@@ -36,3 +36,57 @@ TEST_F(Tst_Scrollwidgetagent, scrollWidgetAgent_test)
     agent.setPosType(PosType::Pos_RR);
     agent.setBlurBoxWidget(blueBox);
 }
+
+TEST_F(Tst_Scrollwidgetagent, scrollSnapshot_test)
+{
+    ScrollWidgetAgent agent;
+    QWidget *w = new QWidget;
+    agent.setControlWidget(w);
+
+    BlurBoxWidget *blueBox = new BlurBoxWidget(AppsListModel::Chat, const_cast<char *>("Chat"), w);
+    agent.setPosType(PosType::Pos_M);
+    agent.setBlurBoxWidget(blueBox);
+    w->show();
+    agent.setVisible(true);
+
+    // 滑动过程中显示截图, 隐藏分类控件
+    agent.m_animation->setDuration(200);
+    agent.animationStateChanged(QAbstractAnimation::Running);
+    EXPECT_TRUE(agent.m_useSnapshot);
+    EXPECT_FALSE(blueBox->isVisible());
+    EXPECT_TRUE(agent.m_snapshotLabel->isVisible());
+
+    agent.setPos(QPoint(10, 0));
+    EXPECT_EQ(agent.m_snapshotLabel->pos(), QPoint(10, 0));
+
+    // 遮罩或显示状态变化时沿用滑动开始时的截图, 只移动位置
+    const qint64 snapshotKey = agent.m_snapshotLabel->pixmap()->cacheKey();
+    agent.setPosType(PosType::Pos_L);
+    agent.setVisible(false);
+    agent.setPos(QPoint(20, 0));
+    agent.setVisible(true);
+    EXPECT_EQ(agent.m_snapshotLabel->pixmap()->cacheKey(), snapshotKey);
+    EXPECT_EQ(agent.m_snapshotLabel->pos(), QPoint(20, 0));
+    EXPECT_FALSE(blueBox->isVisible());
+
+    // 滑动过程中重新绑定分类控件后, 清除旧控件的截图, 再次显示时重新截图
+    BlurBoxWidget *otherBox = new BlurBoxWidget(AppsListModel::Music, const_cast<char *>("Music"), w);
+    agent.setBlurBoxWidget(otherBox);
+    EXPECT_FALSE(agent.m_snapshotTaken);
+    EXPECT_FALSE(agent.m_snapshotLabel->isVisible());
+    agent.setVisible(true);
+    EXPECT_TRUE(agent.m_snapshotTaken);
+    EXPECT_NE(agent.m_snapshotLabel->pixmap()->cacheKey(), snapshotKey);
+    EXPECT_FALSE(otherBox->isVisible());
+
+    agent.setBlurBoxWidget(blueBox);
+    agent.setVisible(true);
+
+    // 滑动结束后恢复分类控件
+    agent.animationStateChanged(QAbstractAnimation::Stopped);
+    EXPECT_FALSE(agent.m_useSnapshot);
+    EXPECT_TRUE(blueBox->isVisible());
+    EXPECT_FALSE(agent.m_snapshotLabel->isVisible());
+
+    delete w;
+}